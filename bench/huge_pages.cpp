@@ -0,0 +1,77 @@
+// Random field reads through a runtime view and through a huge page backed field index
+// Usage: huge_pages [rows] [reads], defaults to 4M rows of 8 columns and 20M reads
+#include "../include/huge_pages.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+
+constexpr size_t column_count = 8;
+
+// Time reads of the fields at the given locations, returning the seconds taken
+// The field sizes are summed so the reads are not optimized away
+template <typename Read>
+static double time_reads(const std::vector<std::pair<size_t, size_t>>& locations, Read read, size_t& checksum) {
+    auto start = std::chrono::steady_clock::now();
+    for (auto [column_index, row_index] : locations)
+        checksum += read(column_index, row_index).size();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t{ 4 } << 20;
+    size_t reads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000000;
+    auto path = std::filesystem::temp_directory_path() / "cppsv_huge_pages_bench.csv";
+    {
+        auto file = std::ofstream(path, std::ios::binary);
+        std::string line;
+        for (size_t row_index = 0; row_index <= rows; ++row_index) {
+            line.clear();
+            for (size_t column_index = 0; column_index < column_count; ++column_index) {
+                if (column_index) line += ',';
+                line += std::to_string(row_index * column_count + column_index);
+            }
+            line += '\n';
+            file << line;
+        }
+    }
+    auto rng = std::mt19937_64(1);
+    auto locations = std::vector<std::pair<size_t, size_t>>(reads);
+    for (auto& location : locations)
+        location = { rng() % column_count, rng() % (rows + 1) };
+    size_t checksum = 0;
+
+    // A plain view, one allocation per row of its field table
+    double plain_seconds;
+    {
+        auto file = std::ifstream(path, std::ios::binary);
+        auto data = std::string(std::istreambuf_iterator<char>(file), {});
+        auto view = cppsv::runtime_cppsv_view<char>(std::move(data));
+        plain_seconds = time_reads(locations, [&](size_t column_index, size_t row_index) {
+            return view.get_row(row_index)[column_index];
+        }, checksum);
+    }
+
+    // The csv buffer and the field index backed by huge pages
+    double huge_page_seconds;
+    {
+        auto buffer = cppsv::read_file_huge_pages<char>(path);
+        if (!buffer) return 1;
+        auto view = cppsv::runtime_cppsv_view<char>::from_buffer(*buffer);
+        auto fields = cppsv::huge_page_fields<char>(view);
+        huge_page_seconds = time_reads(locations, [&](size_t column_index, size_t row_index) {
+            return fields.get_field(column_index, row_index);
+        }, checksum);
+    }
+    std::filesystem::remove(path);
+
+    std::printf("%zu rows, %zu random reads (checksum %zu)\n", rows, reads, checksum);
+    std::printf("runtime_cppsv_view: %.3fs\n", plain_seconds);
+    std::printf("huge_page_fields:   %.3fs\n", huge_page_seconds);
+    return 0;
+}
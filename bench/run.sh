@@ -0,0 +1,12 @@
+#!/bin/sh
+# Build and run every benchmark with optimizations
+# Usage: bench/run.sh [compiler], the compiler defaults to $CXX or g++
+cd "$(dirname "$0")" || exit 1
+CXX=${1:-${CXX:-g++}}
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+for bench in *.cpp; do
+    name=${bench%.cpp}
+    echo "$name:"
+    "$CXX" -std=c++20 -O2 -DNDEBUG -pthread -o "$OUT/$name" "$bench" && "$OUT/$name" || exit 1
+done
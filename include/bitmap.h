@@ -0,0 +1,98 @@
+#ifndef CPPSV_INCLUDE_BITMAP_H
+#define CPPSV_INCLUDE_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <vector>
+#include <algorithm>
+
+namespace cppsv {
+    // A fixed size bitmap over rows, stored in 64-bit words
+    // Bit i of the bitmap is bit (i % 64) of word (i / 64), matching the
+    // least significant bit first layout of Arrow bitmaps on little endian targets
+    // Bits past size() in the last word are always zero
+    class bitmap {
+        std::vector<uint64_t> words;
+        size_t bits;
+
+        void clear_tail() noexcept {
+            if (this->bits % 64)
+                this->words.back() &= (uint64_t{ 1 } << (this->bits % 64)) - 1;
+        }
+    public:
+        explicit bitmap(size_t size = 0, bool value = false) noexcept
+            : words((size + 63) / 64, value ? ~uint64_t{} : uint64_t{}), bits(size) {
+            this->clear_tail();
+        }
+
+        // Get the number of bits
+        size_t size() const noexcept {
+            return this->bits;
+        }
+
+        // Get the number of set bits
+        size_t count() const noexcept {
+            size_t out = 0;
+            for (auto word : this->words)
+                out += std::popcount(word);
+            return out;
+        }
+
+        bool test(size_t index) const noexcept {
+            return this->words[index / 64] >> (index % 64) & 1;
+        }
+
+        void set(size_t index, bool value = true) noexcept {
+            uint64_t mask = uint64_t{ 1 } << (index % 64);
+            if (value)
+                this->words[index / 64] |= mask;
+            else
+                this->words[index / 64] &= ~mask;
+        }
+
+        // Invert all bits
+        bitmap& flip() noexcept {
+            for (auto& word : this->words)
+                word = ~word;
+            this->clear_tail();
+            return *this;
+        }
+
+        // Bitmaps of different sizes are combined as if the shorter one was padded with zeros,
+        // the size is unchanged
+        bitmap& operator&=(const bitmap& other) noexcept {
+            for (size_t index = 0; index < this->words.size(); ++index)
+                this->words[index] &= index < other.words.size() ? other.words[index] : 0;
+            this->clear_tail();
+            return *this;
+        }
+
+        bitmap& operator|=(const bitmap& other) noexcept {
+            for (size_t index = 0; index < std::min(this->words.size(), other.words.size()); ++index)
+                this->words[index] |= other.words[index];
+            this->clear_tail();
+            return *this;
+        }
+
+        // Word access, for kernels producing or consuming 64 bits at a time
+        std::vector<uint64_t>& data() noexcept {
+            return this->words;
+        }
+
+        const std::vector<uint64_t>& data() const noexcept {
+            return this->words;
+        }
+
+        // Iterate over the indices of all set bits in ascending order,
+        // calling "function(size_t)"
+        void for_each_set(auto function) const noexcept {
+            for (size_t index = 0; index < this->words.size(); ++index) {
+                for (uint64_t word = this->words[index]; word; word &= word - 1)
+                    function(index * 64 + std::countr_zero(word));
+            }
+        }
+    };
+}
+
+#endif /* CPPSV_INCLUDE_BITMAP_H */
@@ -1,8 +1,27 @@
 #ifndef CPPSV_INCLUDE_CONVERT_H
 #define CPPSV_INCLUDE_CONVERT_H
 
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <chrono>
+#include <limits>
+#include <array>
+#include <memory>
+#include <concepts>
+#include <tuple>
+#include <utility>
+#include <iterator>
 #include <optional>
 #include <algorithm>
+#include <type_traits>
+
+#include "cppsv_common.h"
+#include "perfect_hash.h"
+
+#ifdef CPPSV_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace cppsv {
     // Convert a single character that represents
@@ -32,50 +51,67 @@ namespace cppsv {
         return -1; // Not an ASCII letter
     }
 
+    // Trim leading spaces and trailing spaces and null characters from a character range
+    template <typename It>
+    inline constexpr std::pair<It, It> trim_range(It first, It last) noexcept {
+        while (first != last && *first == ' ')
+            ++first;
+        while (first != last && (*(last - 1) == ' ' || *(last - 1) == '\0'))
+            --last;
+        return { first, last };
+    }
+
+    // Separators of formatted numbers, e.g. { ',', '.' } for "1.234,56"
+    // Both are compile time parameters of the converters, so there is no runtime locale lookup
+    struct number_format {
+        char decimal = '.';
+        char group = '\0'; // No digit grouping if '\0'
+        bool trim = true;   // Trim spaces and null characters, not needed for fields trimmed while tokenizing
+    };
+
+    // Check if a character at "it" is a digit group separator, placed between two digits
+    // Never matches if Group is '\0'
+    template <char Group, typename It>
+    inline constexpr bool is_group_separator(It it, It first, It last, int base = 10) noexcept {
+        if constexpr (Group == '\0') return false;
+        else return *it == Group && it != first && it + 1 != last
+            && chrdigit(*(it - 1), base) >= 0 && chrdigit(*(it + 1), base) >= 0;
+    }
+
     // Convert a character range between first and last to an integer
-    // Supports base 2, 10 and 16 prefixes, radixes 2-36
-    template <typename Integer, typename It>
+    // Supports base 2, 8 and 16 prefixes, radixes 2-36, a leading sign
+    // and digit group separators of Format (e.g. "1,000" with ',')
+    template <typename Integer, typename It, number_format Format = number_format{}>
     inline constexpr std::optional<Integer> to_integer(It first, It last, Integer = {}, int radix = 10) noexcept {
         // Trim leading and trailing characters
-        do {
-            if (first == last) return std::nullopt;
-            auto prev = last - 1;
-            if (*first == ' ')
-                ++first;
-            else if(*prev == ' ' || *prev == '\0')
-                last = prev;
-            else break;
-        } while (true);
+        if constexpr (Format.trim) std::tie(first, last) = trim_range(first, last);
+        if (first == last) return std::nullopt;
         bool sign = *first == '-';
-        if (sign) ++first;
+        if (sign || *first == '+') ++first;
         if (first == last) return std::nullopt;
         int base = radix;
         // 0x, 0o, 0b prefix notation check (can use uppercase)
-        if (*first == '0') {
-            It it_chr = ++first;
-            if (it_chr == last) {
-                return Integer{};
-            }
-            auto chr = *it_chr;
-            first = ++it_chr;
-            switch (chrlower(chr)) {
+        if (*first == '0' && last - first > 2) {
+            switch (chrlower(*(first + 1))) {
             case 'x':
                 base = 16;
+                first += 2;
                 break;
             case 'o':
                 base = 8;
+                first += 2;
                 break;
             case 'b':
                 base = 2;
+                first += 2;
                 break;
-            default:
-                if (chrdigit(chr, 10) < 0) return std::nullopt;
             }
         }
+        auto digits_first = first;
         Integer result{};
-        while (first != last) {
-            auto chr = *(first++);
-            int digit = chrdigit(chr, base);
+        for (; first != last; ++first) {
+            if (is_group_separator<Format.group>(first, digits_first, last, base)) continue;
+            int digit = chrdigit(*first, base);
             if (digit < 0) return std::nullopt;
             result = result * base + digit;
         }
@@ -108,23 +144,468 @@ namespace cppsv {
         else return default_result;
     }
 
+    // Get an integer power of two, exact if representable (including subnormal powers)
+    template <typename Fp>
+    inline constexpr Fp power_of_two(int exponent) noexcept {
+        // Scale in steps of at most 2^62, which are exactly representable
+        Fp out = static_cast<Fp>(1.0);
+        while (exponent > 0) {
+            int step = exponent < 62 ? exponent : 62;
+            out *= static_cast<Fp>(uint64_t{ 1 } << step);
+            exponent -= step;
+        }
+        while (exponent < 0) {
+            int step = -exponent < 62 ? -exponent : 62;
+            out /= static_cast<Fp>(uint64_t{ 1 } << step);
+            exponent += step;
+        }
+        return out;
+    }
+
+    // Floating point number with twice the precision of Fp, as the unevaluated sum hi + lo
+    // Uses error free transformations, so it works in constant evaluated contexts
+    template <typename Fp>
+    struct double_fp {
+        Fp hi;
+        Fp lo;
+
+        // Sum of a and b where |a| >= |b|
+        static constexpr double_fp quick_two_sum(Fp a, Fp b) noexcept {
+            Fp sum = a + b;
+            return { sum, b - (sum - a) };
+        }
+
+        // Exact product of a and b (Dekker)
+        static constexpr double_fp two_product(Fp a, Fp b) noexcept {
+            constexpr Fp splitter = static_cast<Fp>((uint64_t{ 1 } << ((std::numeric_limits<Fp>::digits + 1) / 2)) + 1);
+            auto split = [=](Fp value) {
+                Fp scaled = splitter * value;
+                Fp hi = scaled - (scaled - value);
+                return double_fp{ hi, value - hi };
+            };
+            auto [a_hi, a_lo] = split(a);
+            auto [b_hi, b_lo] = split(b);
+            Fp product = a * b;
+            return { product, ((a_hi * b_hi - product) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo };
+        }
+
+        // Quotient of a and b
+        static constexpr double_fp quotient(Fp a, Fp b) noexcept {
+            Fp first = a / b;
+            auto product = two_product(first, b);
+            return quick_two_sum(first, ((a - product.hi) - product.lo) / b);
+        }
+
+        // Exact sum of a and b
+        static constexpr double_fp two_sum(Fp a, Fp b) noexcept {
+            Fp sum = a + b;
+            Fp b_part = sum - a;
+            return { sum, (a - (sum - b_part)) + (b - b_part) };
+        }
+
+        friend constexpr double_fp operator+(double_fp lhs, double_fp rhs) noexcept {
+            auto sum = two_sum(lhs.hi, rhs.hi);
+            return quick_two_sum(sum.hi, sum.lo + (lhs.lo + rhs.lo));
+        }
+
+        friend constexpr double_fp operator*(double_fp lhs, double_fp rhs) noexcept {
+            auto product = two_product(lhs.hi, rhs.hi);
+            return quick_two_sum(product.hi, product.lo + (lhs.hi * rhs.lo + lhs.lo * rhs.hi));
+        }
+
+        constexpr Fp value() const noexcept {
+            return this->hi + this->lo;
+        }
+    };
+
+    // Convert value * 2^exponent to Fp, where value is a non-negative double_fp
+    // with its high part in [1, 2]
+    // The result is rounded once, also if it is subnormal, and overflow produces infinity
+    // If value is exact, ties are rounded to even by it
+    // Otherwise "compare(units, unit_exponent)" decides when value is too close to halfway
+    // between two results to round by it: it compares the exact number
+    // to (units + 1/2) * 2^unit_exponent, returning a negative number if it is below, 0 if equal, positive if above
+    template <typename Fp, typename Compare = std::nullptr_t>
+    inline constexpr Fp round_scaled(double_fp<Fp> value, int exponent, Compare compare = nullptr) noexcept {
+        using limits = std::numeric_limits<Fp>;
+        // Exponent of the smallest subnormal number
+        constexpr int min_exponent = limits::min_exponent - limits::digits;
+        while (value.hi >= static_cast<Fp>(2.0)) {
+            value = { value.hi / 2, value.lo / 2 };
+            ++exponent;
+        }
+        // Values just below 2^max_exponent may still round to the largest finite number
+        if (exponent > limits::max_exponent) return limits::infinity();
+        // Exponent of the last bit of the result, fixed for subnormal results
+        int unit_exponent = std::max(exponent - (limits::digits - 1), min_exponent);
+        int shift = exponent - unit_exponent;
+        if (shift < -1) return Fp{};
+        // Split value into whole units of the last bit and the rest, in [0, 1)
+        Fp scale = power_of_two<Fp>(shift);
+        Fp hi = value.hi * scale;
+        auto units = static_cast<uint64_t>(hi);
+        // hi - units is exact, lo is much smaller
+        Fp rest = (hi - static_cast<Fp>(units)) + value.lo * scale;
+        if (rest < 0 && units) {
+            --units;
+            rest += 1;
+            // Below a power of two, the last bit is worth half as much
+            if (units < uint64_t{ 1 } << (limits::digits - 1) && unit_exponent > min_exponent) {
+                bool bit = rest >= static_cast<Fp>(0.5);
+                units = units * 2 + bit;
+                rest = rest * 2 - bit;
+                --unit_exponent;
+            }
+        }
+        // Round half to even
+        bool round_up;
+        if constexpr (std::is_null_pointer_v<Compare>)
+            round_up = rest > static_cast<Fp>(0.5) || (rest == static_cast<Fp>(0.5) && units & 1);
+        else {
+            // The error of value is far below this
+            constexpr Fp tolerance = power_of_two<Fp>(-(limits::digits / 2));
+            Fp distance = rest - static_cast<Fp>(0.5);
+            if (distance < tolerance && -distance < tolerance) {
+                int order = compare(units, unit_exponent);
+                round_up = order > 0 || (!order && units & 1);
+            }
+            else round_up = distance > 0;
+        }
+        // Exact, also if units + 1 is a power of two past the range of uint64_t
+        Fp result = static_cast<Fp>(units) + static_cast<Fp>(round_up);
+        // Overflow is not a constant expression, check for it first
+        int headroom = limits::max_exponent - unit_exponent;
+        if (headroom <= limits::digits && result >= power_of_two<Fp>(headroom)) return limits::infinity();
+        return result * power_of_two<Fp>(unit_exponent);
+    }
+
+    // Powers of ten for converting decimal numbers to Fp
+    // A power of ten 10^k is stored as mantissa * 2^exponent with a mantissa in [1, 2),
+    // so no entry overflows or underflows, even for subnormal results
+    // 10^k is looked up as large[k / 32] * small[k % 32], two rounded multiplications
+    // at twice the precision of Fp, so any exponent is O(1) and accurate
+    template <typename Fp>
+    struct pow10_table {
+        using limits = std::numeric_limits<Fp>;
+        using double_type = double_fp<Fp>;
+
+        struct entry {
+            double_type mantissa;
+            int exponent;
+
+            friend constexpr entry operator*(entry lhs, entry rhs) noexcept {
+                auto out = entry{ lhs.mantissa * rhs.mantissa, lhs.exponent + rhs.exponent };
+                // Renormalize the mantissa to [1, 2), exact
+                if (out.mantissa.hi >= static_cast<Fp>(2.0)) {
+                    out.mantissa = { out.mantissa.hi / 2, out.mantissa.lo / 2 };
+                    ++out.exponent;
+                }
+                else if (out.mantissa.hi < static_cast<Fp>(1.0)) {
+                    out.mantissa = { out.mantissa.hi * 2, out.mantissa.lo * 2 };
+                    --out.exponent;
+                }
+                return out;
+            }
+        };
+
+        static constexpr entry one{ { 1, 0 }, 0 };
+        // 10 = 1.25 * 2^3
+        static constexpr entry ten{ { static_cast<Fp>(1.25), 0 }, 3 };
+        // 0.1 = 1.6 * 2^-4, 1.6 is not exactly representable
+        static constexpr entry tenth{ double_type::quotient(16, 10), -4 };
+
+        // Exponent range of the last digit of decimal numbers with up to 38 significant digits
+        // that are neither zero nor infinity when converted
+        static constexpr int min_exponent = limits::min_exponent10 - limits::max_digits10 - 40;
+        static constexpr int max_exponent = limits::max_exponent10 + 1;
+        static constexpr int min_large = -((-min_exponent + 31) / 32);
+        static constexpr int max_large = max_exponent / 32;
+
+        static constexpr entry power(entry base, int count) noexcept {
+            entry out = one;
+            while (count--)
+                out = out * base;
+            return out;
+        }
+
+        static constexpr auto small = []{
+            std::array<entry, 32> out{};
+            for (int index = 0; index < 32; ++index)
+                out[index] = power(ten, index);
+            return out;
+        }();
+
+        static constexpr auto large = []{
+            std::array<entry, max_large - min_large + 1> out{};
+            entry positive = power(ten, 32);
+            entry negative = power(tenth, 32);
+            for (int index = 0; index <= max_large; ++index)
+                out[index - min_large] = power(positive, index);
+            for (int index = -1; index >= min_large; --index)
+                out[index - min_large] = power(negative, -index);
+            return out;
+        }();
+
+        // Largest power of ten that is exactly representable (5^k < 2^digits)
+        static constexpr int max_exact = []{
+            constexpr int bits = limits::digits < 64 ? limits::digits : 63;
+            constexpr uint64_t limit = uint64_t{ 1 } << bits;
+            int out = 0;
+            for (uint64_t power = 5; power < limit; power *= 5) {
+                ++out;
+                // The next power would wrap around
+                if (power > limit / 5) break;
+            }
+            return out;
+        }();
+
+        static constexpr uint64_t max_exact_mantissa = uint64_t{ 1 } << (limits::digits < 64 ? limits::digits : 63);
+
+        static constexpr auto exact = []{
+            std::array<Fp, max_exact + 1> out{};
+            out[0] = 1;
+            for (int index = 1; index <= max_exact; ++index)
+                out[index] = out[index - 1] * 10;
+            return out;
+        }();
+
+        static constexpr entry get(int exponent) noexcept {
+            int index = exponent >= 0 ? exponent / 32 : -((-exponent + 31) / 32);
+            return large[index - min_large] * small[exponent - index * 32];
+        }
+    };
+
+    // Get mantissa * 10^exponent as a double_fp with its high part in [1, 4) and a binary exponent
+    template <typename Fp>
+    inline constexpr std::pair<double_fp<Fp>, int> scaled_product(uint64_t mantissa, int exponent) noexcept {
+        // Normalize the mantissa to [1, 2) as well
+        int shift = static_cast<int>(std::bit_width(mantissa)) - 1;
+        Fp hi = static_cast<Fp>(mantissa);
+        Fp lo = static_cast<Fp>(static_cast<int64_t>(mantissa - static_cast<uint64_t>(hi)));
+        Fp scale = power_of_two<Fp>(-shift);
+        auto power = pow10_table<Fp>::get(exponent);
+        return { double_fp<Fp>::quick_two_sum(hi * scale, lo * scale) * power.mantissa, shift + power.exponent };
+    }
+
+    // Unsigned integer of up to Limbs 32-bit limbs, for exact comparisons while rounding
+    template <size_t Limbs>
+    struct big_integer {
+        std::array<uint32_t, Limbs> limbs{};
+        // Number of limbs in use, the highest one is not zero
+        size_t size = 0;
+
+        constexpr big_integer(uint64_t value) noexcept {
+            this->add(value);
+        }
+
+        constexpr void add(uint64_t value) noexcept {
+            for (size_t index = 0; value; ++index) {
+                if (index == this->size) ++this->size;
+                uint64_t sum = this->limbs[index] + (value & UINT32_MAX);
+                this->limbs[index] = static_cast<uint32_t>(sum);
+                value = (value >> 32) + (sum >> 32);
+            }
+        }
+
+        constexpr void multiply(uint32_t factor) noexcept {
+            uint64_t carry = 0;
+            for (size_t index = 0; index < this->size; ++index) {
+                uint64_t product = uint64_t{ this->limbs[index] } * factor + carry;
+                this->limbs[index] = static_cast<uint32_t>(product);
+                carry = product >> 32;
+            }
+            if (carry) this->limbs[this->size++] = static_cast<uint32_t>(carry);
+        }
+
+        constexpr void multiply_power_of_five(int count) noexcept {
+            // 5^13 is the largest power of five below 2^32
+            for (; count >= 13; count -= 13)
+                this->multiply(1220703125);
+            uint32_t factor = 1;
+            while (count--) factor *= 5;
+            this->multiply(factor);
+        }
+
+        constexpr void shift_left(size_t count) noexcept {
+            if (!this->size) return;
+            size_t words = count / 32;
+            unsigned int bits = count % 32;
+            if (bits && this->limbs[this->size - 1] >> (32 - bits)) this->limbs[this->size++] = 0;
+            for (size_t index = this->size; index--;) {
+                uint32_t low = bits && index ? this->limbs[index - 1] >> (32 - bits) : 0;
+                this->limbs[index + words] = (bits ? this->limbs[index] << bits : this->limbs[index]) | low;
+            }
+            for (size_t index = 0; index < words; ++index)
+                this->limbs[index] = 0;
+            this->size += words;
+        }
+
+        friend constexpr int compare(const big_integer& lhs, const big_integer& rhs) noexcept {
+            if (lhs.size != rhs.size) return lhs.size < rhs.size ? -1 : 1;
+            for (size_t index = lhs.size; index--;)
+                if (lhs.limbs[index] != rhs.limbs[index]) return lhs.limbs[index] < rhs.limbs[index] ? -1 : 1;
+            return 0;
+        }
+    };
+
+    // Compare (mantissa * 10^tail_digits + tail) * 10^exponent
+    // to (units + 1/2) * 2^unit_exponent exactly, for rounding to Fp
+    // Returns a negative number if it is below, 0 if equal, positive if above
+    template <typename Fp>
+    inline constexpr int compare_halfway(uint64_t mantissa, uint64_t tail, int tail_digits, int exponent,
+        uint64_t units, int unit_exponent) noexcept {
+        using table = pow10_table<Fp>;
+        // Both sides are close to each other, so neither takes more bits
+        // than the digits and the largest power of five in the exponent range (log2(5) < 2.33)
+        constexpr size_t bits = std::max(-table::min_exponent, table::max_exponent) * 233 / 100 + 256;
+        using integer = big_integer<bits / 32>;
+        integer lhs = mantissa;
+        lhs.multiply_power_of_five(tail_digits);
+        lhs.shift_left(tail_digits);
+        lhs.add(tail);
+        integer rhs = units;
+        rhs.shift_left(1);
+        rhs.add(1);
+        // lhs * 5^exponent * 2^exponent against rhs * 2^(unit_exponent - 1)
+        if (exponent >= 0) lhs.multiply_power_of_five(exponent);
+        else rhs.multiply_power_of_five(-exponent);
+        int shift = exponent - (unit_exponent - 1);
+        if (shift >= 0) lhs.shift_left(shift);
+        else rhs.shift_left(-shift);
+        return compare(lhs, rhs);
+    }
+
+    // Convert (mantissa * 10^tail_digits + tail) * 10^exponent to Fp,
+    // the tail holds significant digits past the first 19
+    template <typename Fp>
+    inline constexpr Fp scale_by_power_of_ten(uint64_t mantissa, int64_t exponent,
+        uint64_t tail = 0, int tail_digits = 0) noexcept {
+        using table = pow10_table<Fp>;
+        if (!mantissa) return Fp{};
+        // Scale by the digits of the tail, also if they are all zeros
+        exponent += tail_digits;
+        // Both operands are exact, the result is correctly rounded
+        if (!tail && mantissa <= table::max_exact_mantissa
+            && exponent >= -table::max_exact && exponent <= table::max_exact) {
+            Fp value = static_cast<Fp>(mantissa);
+            return exponent < 0 ? value / table::exact[-exponent] : value * table::exact[exponent];
+        }
+        if (exponent < table::min_exponent + 20) return Fp{};
+        if (exponent > table::max_exponent) return std::numeric_limits<Fp>::infinity();
+        auto [value, binary_exponent] = scaled_product<Fp>(mantissa, static_cast<int>(exponent));
+        if (tail) {
+            auto [tail_value, tail_exponent] = scaled_product<Fp>(tail, static_cast<int>(exponent) - tail_digits);
+            Fp scale = power_of_two<Fp>(tail_exponent - binary_exponent);
+            value = value + double_fp<Fp>{ tail_value.hi * scale, tail_value.lo * scale };
+        }
+        // Close to halfway between two results, round by the exact decimal number
+        return round_scaled(value, binary_exponent, [&](uint64_t units, int unit_exponent) {
+            return compare_halfway<Fp>(mantissa, tail, tail_digits,
+                static_cast<int>(exponent) - tail_digits, units, unit_exponent);
+        });
+    }
+
     // Convert a character range between first and last to a floating point number
-    // Supports normal and E notation, but not hexadecimal floating poing notation
-    template <typename Fp, typename It>
+    // in hexadecimal floating point notation, without the sign and "0x" prefix (e.g. "1.8p3")
+    // The binary exponent ("p3") is optional
+    // Uses the separators of Format, group separators are only skipped in the whole part
+    // At least 16 significant digits are accumulated exactly, one more is kept as a guard digit
+    // and further digits only decide whether the number is above them (a sticky bit),
+    // so the result is correctly rounded
+    template <typename Fp, typename It, number_format Format = number_format{}>
+    inline constexpr std::optional<Fp> to_hex_floating_point(It first, It last, Fp = {}) noexcept {
+        uint64_t mantissa = 0;
+        // Exponent of the last bit of the mantissa
+        int exponent = 0;
+        // The first digit past the mantissa
+        int guard = 0;
+        bool truncated = false;
+        // Some of the digits past the guard digit are not zero
+        bool sticky = false;
+        bool fraction = false;
+        bool has_digits = false;
+        for (auto digits_first = first; first != last; ++first) {
+            auto chr = *first;
+            if (!fraction && is_group_separator<Format.group>(first, digits_first, last, 16)) continue;
+            if (chr == Format.decimal && !fraction) {
+                fraction = true;
+                continue;
+            }
+            if (chrlower(chr) == 'p') break;
+            int digit = chrdigit(chr, 16);
+            if (digit < 0) return std::nullopt;
+            has_digits = true;
+            if (!(mantissa >> 60)) {
+                mantissa = mantissa * 16 + static_cast<uint64_t>(digit);
+                if (fraction) exponent -= 4;
+            }
+            else {
+                if (truncated) sticky |= digit != 0;
+                else guard = digit;
+                truncated = true;
+                if (!fraction) exponent += 4;
+            }
+        }
+        if (!has_digits) return std::nullopt;
+        if (first != last) {
+            // Binary exponent, in decimal
+            auto exponent_opt = to_integer(++first, last, 0);
+            if (!exponent_opt) return std::nullopt;
+            exponent += exponent_opt.value();
+        }
+        if (!mantissa) return Fp{};
+        // Split the mantissa into a rounded high part and the exact rest
+        Fp hi = static_cast<Fp>(mantissa);
+        Fp lo;
+        if (hi >= power_of_two<Fp>(64)) lo = -static_cast<Fp>(uint64_t{ 0 } - mantissa);
+        else {
+            auto rounded = static_cast<uint64_t>(hi);
+            lo = mantissa >= rounded ? static_cast<Fp>(mantissa - rounded) : -static_cast<Fp>(rounded - mantissa);
+        }
+        // The guard digit may be past the precision of hi, carry it over into hi
+        auto value = double_fp<Fp>::quick_two_sum(hi, lo + static_cast<Fp>(guard) / 16);
+        // Scale the high part to [1, 2]
+        int top_bit = static_cast<int>(std::bit_width(mantissa)) - 1;
+        Fp scale = power_of_two<Fp>(-top_bit);
+        // Close to halfway between two results, compare the exact number to the halfway point
+        return round_scaled(double_fp<Fp>{ value.hi * scale, value.lo * scale }, exponent + top_bit,
+            [&](uint64_t units, int unit_exponent) {
+            // (mantissa * 16 + guard) * 2^(exponent - 4) against (2 * units + 1) * 2^(unit_exponent - 1)
+            using integer = big_integer<8>;
+            integer lhs = mantissa;
+            lhs.shift_left(4);
+            lhs.add(static_cast<uint64_t>(guard));
+            integer rhs = units;
+            rhs.shift_left(1);
+            rhs.add(1);
+            int shift = exponent - 4 - (unit_exponent - 1);
+            if (shift >= 0) lhs.shift_left(static_cast<size_t>(shift));
+            else rhs.shift_left(static_cast<size_t>(-shift));
+            int order = compare(lhs, rhs);
+            return order || !sticky ? order : 1;
+        });
+    }
+
+    // Convert a character range between first and last to a floating point number
+    // Supports normal, E and hexadecimal floating point ("0x1.8p3") notation, a leading sign
+    // and the separators of Format (e.g. "1.000,5" with { ',', '.' })
+    // Decimal numbers are correctly rounded for up to 38 significant digits at any exponent,
+    // further digits are truncated
+    template <typename Fp, typename It, number_format Format = number_format{}>
     inline constexpr std::optional<Fp> to_floating_point(It first, It last, Fp = {}) noexcept {
+        static_assert(Format.decimal != Format.group, "decimal and group separators must differ");
         // Trim leading and trailing characters
-        do {
-            if (first == last) return std::nullopt;
-            auto prev = last - 1;
-            if (*first == ' ')
-                ++first;
-            else if(*prev == ' ' || *prev == '\0')
-                last = prev;
-            else break;
-        } while (true);
+        if constexpr (Format.trim) std::tie(first, last) = trim_range(first, last);
+        if (first == last) return std::nullopt;
         bool sign = *first == '-';
-        if (sign) ++first;
+        if (sign || *first == '+') ++first;
         if (first == last) return std::nullopt;
+        // Hexadecimal floating point notation
+        if (last - first > 2 && *first == '0' && chrlower(*(first + 1)) == 'x') {
+            auto result = to_hex_floating_point<Fp, It, Format>(first + 2, last, Fp{});
+            if (!result) return std::nullopt;
+            return sign ? -result.value() : result.value();
+        }
         // Could be a FP constant ("nan", "inf", "infinity" in any case)
         if (chrlower(*first) == 'i' || chrlower(*first) == 'n') {
             Fp default_result = Fp{};
@@ -138,41 +619,414 @@ namespace cppsv {
         It first_exp = first;
         while (++first_exp != last)
             if (chrlower(*first_exp) == 'e') break;
-        // Calculate base 10 whole part
-        // Iterate from most significant digit forward
-        Fp result{};
-        auto last_decimal = first_exp;
-        while (first != last_decimal) {
-            auto chr = *(first++);
-            if (chr == '.') break;
-            int digit = chrdigit(chr, 10);
-            if (digit < 0) return std::nullopt;
-            result = result * static_cast<Fp>(10.0) + static_cast<Fp>(digit);
-        }
-        // Calculate base 10 fractional part
-        // Iterate from least significant digit backward
-        Fp decimals{};
-        while (first != last_decimal) {
-            auto chr = *(--last_decimal);
+        // Accumulate up to 38 significant digits into two 64-bit words,
+        // and the decimal exponent of the last accumulated digit
+        constexpr int max_digits = 19;
+        uint64_t mantissa = 0;
+        uint64_t tail = 0;
+        int64_t exponent = 0;
+        int digits = 0;
+        int tail_digits = 0;
+        bool fraction = false;
+        bool has_digits = false;
+        for (auto digits_first = first; first != first_exp; ++first) {
+            auto chr = *first;
+            if (!fraction && is_group_separator<Format.group>(first, digits_first, first_exp)) continue;
+            if (chr == Format.decimal && !fraction) {
+                fraction = true;
+                continue;
+            }
             int digit = chrdigit(chr, 10);
             if (digit < 0) return std::nullopt;
-            decimals = decimals / static_cast<Fp>(10.0) + static_cast<Fp>(digit);
+            has_digits = true;
+            if (digits < max_digits) {
+                // Leading zeros are not significant
+                if (mantissa || digit) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(digit);
+                    ++digits;
+                }
+                if (fraction) --exponent;
+            }
+            else if (tail_digits < max_digits) {
+                tail = tail * 10 + static_cast<uint64_t>(digit);
+                ++tail_digits;
+                if (fraction) --exponent;
+            }
+            // Remaining digits are truncated
+            else if (!fraction) ++exponent;
         }
-        // The first decimal digit is still in the whole part, adjust and add
-        result += decimals / static_cast<Fp>(10.0);
+        if (!has_digits) return std::nullopt;
         if (first_exp != last) {
             // Calculate exponent (integer only!)
-            auto exponent_opt = to_integer(++first_exp, last, 0);
+            auto exponent_opt = to_integer(++first_exp, last, int64_t{});
             if (!exponent_opt) return std::nullopt;
-            int exponent = exponent_opt.value();
-            if (exponent > 0)
-                while (exponent--) result *= static_cast<Fp>(10.0);
-            else if (exponent < 0)
-                while (exponent++) result /= static_cast<Fp>(10.0);
+            // Out of range either way, avoid overflowing the sum
+            exponent += std::clamp<int64_t>(exponent_opt.value(), -100000, 100000);
         }
+        Fp result = scale_by_power_of_ten<Fp>(mantissa, exponent, tail, tail_digits);
         // Return signed result
         return sign ? -result : result;
     }
+
+    // Parse a fixed width run of decimal digits
+    // "valid" is cleared if any of the characters is not a digit
+    template <typename It>
+    inline constexpr int parse_digits(It first, size_t count, bool& valid) noexcept {
+        int out = 0;
+        for (size_t index = 0; index < count; ++index) {
+            auto digit = static_cast<unsigned int>(first[index]) - '0';
+            valid &= digit < 10;
+            out = out * 10 + static_cast<int>(digit);
+        }
+        return out;
+    }
+
+#ifdef CPPSV_SSE2
+    // Parse the fixed width part of "YYYY-MM-DD?HH:MM" into the year, month, day, hour and minute,
+    // '?' may be either 'T' or ' '
+    // All digits and separators are validated in one pass, returns false if any is invalid
+    inline bool parse_datetime_prefix(const char* str, int (&fields)[5]) noexcept {
+        __m128i chrs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+        // Digits: (chr - '0') as unsigned is at most 9
+        __m128i digits = _mm_sub_epi8(chrs, _mm_set1_epi8('0'));
+        int digit_mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits));
+        // Separators, the date/time separator is checked separately
+        __m128i separators = _mm_setr_epi8(0, 0, 0, 0, '-', 0, 0, '-', 0, 0, 0, 0, 0, ':', 0, 0);
+        int separator_mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chrs, separators));
+        constexpr int expected_digits = 0b1101101101101111;
+        constexpr int expected_separators = 0b0010000010010000;
+        if ((digit_mask & expected_digits) != expected_digits
+            || (separator_mask & expected_separators) != expected_separators
+            || (str[10] != 'T' && str[10] != ' '))
+            return false;
+        alignas(16) unsigned char values[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(values), digits);
+        fields[0] = values[0] * 1000 + values[1] * 100 + values[2] * 10 + values[3];
+        fields[1] = values[5] * 10 + values[6];
+        fields[2] = values[8] * 10 + values[9];
+        fields[3] = values[11] * 10 + values[12];
+        fields[4] = values[14] * 10 + values[15];
+        return true;
+    }
+#endif
+
+    // Convert a character range between first and last to a date
+    // Accepts the ISO-8601 calendar date format "YYYY-MM-DD"
+    template <typename It>
+    inline constexpr std::optional<std::chrono::sys_days> to_date(It first, It last) noexcept {
+        std::tie(first, last) = trim_range(first, last);
+        if (last - first != 10) return std::nullopt;
+        bool valid = first[4] == '-' && first[7] == '-';
+        int year = parse_digits(first, 4, valid);
+        int month = parse_digits(first + 5, 2, valid);
+        int day = parse_digits(first + 8, 2, valid);
+        auto date = std::chrono::year_month_day(std::chrono::year(year),
+            std::chrono::month(static_cast<unsigned int>(month)), std::chrono::day(static_cast<unsigned int>(day)));
+        if (!valid || !date.ok()) return std::nullopt;
+        return std::chrono::sys_days(date);
+    }
+
+    // Convert a character range between first and last to a point in time with second precision
+    // Accepts "YYYY-MM-DD", "YYYY-MM-DD HH:MM:SS" and "YYYY-MM-DDTHH:MM:SS",
+    // optionally followed by a fraction of a second (truncated) and "Z" or a "+HH:MM"/"-HH:MM" offset,
+    // or an integer number of seconds since the epoch
+    template <typename It>
+    inline constexpr std::optional<std::chrono::sys_seconds> to_datetime(It first, It last) noexcept {
+        std::tie(first, last) = trim_range(first, last);
+        auto size = last - first;
+        // Epoch time, a date always has a '-' at index 4
+        if (size < 5 || first[4] != '-') {
+            auto seconds = to_integer(first, last, int64_t{});
+            if (!seconds) return std::nullopt;
+            return std::chrono::sys_seconds(std::chrono::seconds(seconds.value()));
+        }
+        if (size < 19) {
+            auto date = to_date(first, last);
+            if (!date) return std::nullopt;
+            return std::chrono::sys_seconds(date.value());
+        }
+        bool valid = true;
+        // Year, month, day, hour and minute
+        int fields[5]{};
+        bool parsed = false;
+#ifdef CPPSV_SSE2
+        if constexpr (std::contiguous_iterator<It> && sizeof(*first) == 1) {
+            if (!std::is_constant_evaluated()) {
+                if (!parse_datetime_prefix(reinterpret_cast<const char*>(std::to_address(first)), fields))
+                    return std::nullopt;
+                parsed = true;
+            }
+        }
+#endif
+        if (!parsed) {
+            valid &= first[4] == '-' && first[7] == '-' && (first[10] == 'T' || first[10] == ' ') && first[13] == ':';
+            fields[0] = parse_digits(first, 4, valid);
+            fields[1] = parse_digits(first + 5, 2, valid);
+            fields[2] = parse_digits(first + 8, 2, valid);
+            fields[3] = parse_digits(first + 11, 2, valid);
+            fields[4] = parse_digits(first + 14, 2, valid);
+        }
+        // The seconds are past the 16 characters parsed at once
+        valid &= first[16] == ':';
+        int second = parse_digits(first + 17, 2, valid);
+        auto date = std::chrono::year_month_day(std::chrono::year(fields[0]),
+            std::chrono::month(static_cast<unsigned int>(fields[1])), std::chrono::day(static_cast<unsigned int>(fields[2])));
+        if (!valid || !date.ok() || fields[3] > 23 || fields[4] > 59 || second > 59) return std::nullopt;
+        auto out = std::chrono::sys_seconds(std::chrono::sys_days(date))
+            + std::chrono::hours(fields[3]) + std::chrono::minutes(fields[4]) + std::chrono::seconds(second);
+        // Fraction of a second, truncated
+        first += 19;
+        if (first != last && *first == '.') {
+            if (++first == last) return std::nullopt;
+            while (first != last && chrdigit(*first, 10) >= 0) ++first;
+        }
+        if (first == last) return out;
+        // UTC designator or offset from UTC
+        if (*first == 'Z') return ++first == last ? std::optional(out) : std::nullopt;
+        if ((*first != '+' && *first != '-') || last - first != 6 || first[3] != ':') return std::nullopt;
+        int offset_hours = parse_digits(first + 1, 2, valid);
+        int offset_minutes = parse_digits(first + 4, 2, valid);
+        if (!valid || offset_hours > 23 || offset_minutes > 59) return std::nullopt;
+        auto offset = std::chrono::hours(offset_hours) + std::chrono::minutes(offset_minutes);
+        return *first == '+' ? out - offset : out + offset;
+    }
+
+    template <typename CharT>
+    struct bool_constants {
+        static constexpr CharT true_[]{ 't', 'r', 'u', 'e' };
+        static constexpr CharT false_[]{ 'f', 'a', 'l', 's', 'e' };
+        static constexpr CharT yes[]{ 'y', 'e', 's' };
+        static constexpr CharT no[]{ 'n', 'o' };
+    };
+
+    // Convert a character range between first and last to a boolean
+    // Accepts "true", "false", "yes", "no" in any case and "1", "0"
+    template <typename It>
+    inline constexpr std::optional<bool> to_boolean(It first, It last) noexcept {
+        using value_type = typename std::iterator_traits<It>::value_type;
+        using constants_type = bool_constants<value_type>;
+        std::tie(first, last) = trim_range(first, last);
+        if (first == last) return std::nullopt;
+        auto pred = [](value_type first, value_type second) { return chrlower(first) == second; };
+        auto matches = [&](const auto& constant) {
+            return std::equal(first, last, std::begin(constant), std::end(constant), pred);
+        };
+        // The first character decides which constant can match
+        switch (chrlower(*first)) {
+        case 't':
+            if (matches(constants_type::true_)) return true;
+            break;
+        case 'y':
+            if (matches(constants_type::yes)) return true;
+            break;
+        case 'f':
+            if (matches(constants_type::false_)) return false;
+            break;
+        case 'n':
+            if (matches(constants_type::no)) return false;
+            break;
+        default:
+            if (last - first == 1 && (*first == '0' || *first == '1')) return *first == '1';
+        }
+        return std::nullopt;
+    }
+
+    // Mapping of strings to enumerators, used by to_enum and convert<Enum>
+    // Specialize for an enumeration with a static constexpr array of name/value pairs, e.g.
+    // template <> struct cppsv::enum_mapping<status> {
+    //     static constexpr std::pair<std::string_view, status> values[]{
+    //         { "open", status::open }, { "closed", status::closed } };
+    // };
+    template <typename Enum>
+    struct enum_mapping;
+
+    template <typename Enum>
+    concept mapped_enum = std::is_enum_v<Enum> && requires { std::size(enum_mapping<Enum>::values); };
+
+    // Perfect hash lookup table over the names of an enum_mapping, built at compile time
+    template <mapped_enum Enum>
+    struct enum_lookup {
+        static constexpr auto& values = enum_mapping<Enum>::values;
+        static constexpr size_t size = std::size(values);
+        using name_type = decltype(std::begin(values)->first);
+        using hash_type = perfect_hash<size>;
+
+        static void duplicate_enum_names() {}
+
+        static constexpr hash_type hash = []{
+            auto names = std::array<name_type, size>{};
+            for (size_t index = 0; index < size; ++index)
+                names[index] = values[index].first;
+            hash_type out{};
+            if (!out.build(names))
+                duplicate_enum_names(); // Compile error: the names of an enum mapping must be unique
+            return out;
+        }();
+
+        // Index into values for every slot of the hash, size if unused
+        static constexpr auto slots = []{
+            auto out = std::array<size_t, hash_type::slot_count>{};
+            out.fill(size);
+            for (size_t index = 0; index < size; ++index)
+                out[hash(values[index].first)] = index;
+            return out;
+        }();
+
+        static constexpr std::optional<Enum> find(name_type name) noexcept {
+            size_t index = slots[hash(name)];
+            if (index == size || values[index].first != name) return std::nullopt;
+            return values[index].second;
+        }
+    };
+
+    // Convert a character range between first and last to an enumerator,
+    // as defined by the enum_mapping of the enumeration
+    template <mapped_enum Enum, typename It>
+    inline constexpr std::optional<Enum> to_enum(It first, It last, Enum = {}) noexcept {
+        std::tie(first, last) = trim_range(first, last);
+        using name_type = typename enum_lookup<Enum>::name_type;
+        return enum_lookup<Enum>::find(name_type(std::to_address(first), last - first));
+    }
+
+    // Fixed point decimal number with Scale digits after the decimal point,
+    // stored as an integer number of units of 10^-Scale
+    template <int Scale>
+    struct decimal {
+        static_assert(Scale >= 0 && Scale <= 18, "decimal scale out of range");
+        static constexpr int scale = Scale;
+        static constexpr int64_t factor = []{
+            int64_t out = 1;
+            for (int index = 0; index < Scale; ++index)
+                out *= 10;
+            return out;
+        }();
+
+        int64_t value;
+
+        constexpr int64_t integer_part() const noexcept {
+            return this->value / factor;
+        }
+
+        constexpr int64_t fractional_part() const noexcept {
+            return this->value % factor;
+        }
+
+        template <typename Fp = double>
+        constexpr Fp to_floating_point() const noexcept {
+            return static_cast<Fp>(this->value) / static_cast<Fp>(factor);
+        }
+
+        friend constexpr auto operator<=>(const decimal&, const decimal&) noexcept = default;
+    };
+
+    template <typename T>
+    inline constexpr bool is_decimal_v = false;
+
+    template <int Scale>
+    inline constexpr bool is_decimal_v<decimal<Scale>> = true;
+
+    // Convert a character range between first and last to a fixed point decimal
+    // Digits past the scale must be zeros, values that do not fit are rejected
+    // Uses the separators of Format
+    template <int Scale, typename It, number_format Format = number_format{}>
+    inline constexpr std::optional<decimal<Scale>> to_decimal(It first, It last, decimal<Scale> = {}) noexcept {
+        static_assert(Format.decimal != Format.group, "decimal and group separators must differ");
+        if constexpr (Format.trim) std::tie(first, last) = trim_range(first, last);
+        if (first == last) return std::nullopt;
+        bool sign = *first == '-';
+        if (sign || *first == '+') ++first;
+        if (first == last) return std::nullopt;
+        // Accumulate negatively, the negative range is larger
+        int64_t result = 0;
+        int fraction_digits = -1;
+        bool has_digits = false;
+        for (auto digits_first = first; first != last; ++first) {
+            auto chr = *first;
+            if (fraction_digits < 0 && is_group_separator<Format.group>(first, digits_first, last)) continue;
+            if (chr == Format.decimal && fraction_digits < 0) {
+                fraction_digits = 0;
+                continue;
+            }
+            int digit = chrdigit(chr, 10);
+            if (digit < 0) return std::nullopt;
+            has_digits = true;
+            if (fraction_digits >= Scale) {
+                if (digit) return std::nullopt; // Not representable
+                continue;
+            }
+            if (fraction_digits >= 0) ++fraction_digits;
+            if (result < (std::numeric_limits<int64_t>::min() + digit) / 10) return std::nullopt;
+            result = result * 10 - digit;
+        }
+        if (!has_digits) return std::nullopt;
+        // Scale up if there were fewer fractional digits than the scale
+        for (int index = fraction_digits < 0 ? 0 : fraction_digits; index < Scale; ++index) {
+            if (result < std::numeric_limits<int64_t>::min() / 10) return std::nullopt;
+            result *= 10;
+        }
+        if (!sign && result == std::numeric_limits<int64_t>::min()) return std::nullopt;
+        return decimal<Scale>{ sign ? result : -result };
+    }
+
+    // Representations of missing values, combined as flags
+    enum null_format : unsigned int {
+        null_empty = 1,        // ""
+        null_literal = 2,      // "NULL"
+        null_na = 4,           // "NA"
+        null_escape = 8,       // "\N"
+        null_default = null_empty | null_literal | null_na | null_escape
+    };
+
+    template <typename CharT>
+    struct null_constants {
+        static constexpr CharT literal[]{ 'N', 'U', 'L', 'L' };
+        static constexpr CharT na[]{ 'N', 'A' };
+        static constexpr CharT escape[]{ '\\', 'N' };
+    };
+
+    // Check if a character range between first and last represents a missing value
+    // "format" is a combination of null_format flags
+    template <typename It>
+    inline constexpr bool is_null(It first, It last, unsigned int format = null_default) noexcept {
+        using constants_type = null_constants<typename std::iterator_traits<It>::value_type>;
+        std::tie(first, last) = trim_range(first, last);
+        switch (last - first) {
+        case 0:
+            return format & null_empty;
+        case 2:
+            return (format & null_na && std::equal(first, last, std::begin(constants_type::na)))
+                || (format & null_escape && std::equal(first, last, std::begin(constants_type::escape)));
+        case 4:
+            return format & null_literal && std::equal(first, last, std::begin(constants_type::literal));
+        default:
+            return false;
+        }
+    }
+
+    // Convert a character range between first and last to T
+    // Integers, floating point numbers, booleans, mapped enumerations, decimals,
+    // dates (std::chrono::sys_days) and points in time (std::chrono::sys_seconds) are parsed,
+    // other types are constructed from the iterator range
+    // Numbers use the separators of Format
+    template <typename T, number_format Format = number_format{}, typename It>
+    inline constexpr std::optional<T> convert(It first, It last) noexcept {
+        if constexpr (std::is_same_v<T, bool>)
+            return to_boolean(first, last);
+        else if constexpr (mapped_enum<T>)
+            return to_enum(first, last, T{});
+        else if constexpr (is_decimal_v<T>)
+            return to_decimal<T::scale, It, Format>(first, last, T{});
+        else if constexpr (std::is_same_v<T, std::chrono::sys_days>)
+            return to_date(first, last);
+        else if constexpr (std::is_same_v<T, std::chrono::sys_seconds>)
+            return to_datetime(first, last);
+        else if constexpr (std::is_integral_v<T>)
+            return to_integer<T, It, Format>(first, last, T{});
+        else if constexpr (std::is_floating_point_v<T>)
+            return to_floating_point<T, It, Format>(first, last, T{});
+        else
+            return T(first, last);
+    }
 }
 
 #endif /* CPPSV_INCLUDE_CONVERT_H */
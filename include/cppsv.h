@@ -17,6 +17,7 @@
 #define CPPSV_VIEW_BEGIN inline constexpr cppsv::cppsv_view<std::forward_as_tuple(
 #define CPPSV_VIEW_NEXT ,
 #define CPPSV_VIEW_NAME(NAME) )> NAME;
+#define CPPSV_VIEW_NAME_WITH_OPTIONS(NAME, ...) ), cppsv::parse_options{ __VA_ARGS__ }> NAME;
 
 namespace cppsv {
     // Only used for pack expansions (ref_array<CharT, Ns>...),
@@ -25,7 +26,8 @@ namespace cppsv {
     using ref_array = const Ref(&)[Size];
 
     // Helper class for validating and concatenating multiple csv strings 
-    template <typename CharT, size_t N>
+    // The bounds of the C concatenated strings (chunks) are kept
+    template <typename CharT, size_t N, size_t C = 1>
     struct cppsv_cat {
         using value_type = CharT;
         using view_type = std::basic_string_view<CharT>;
@@ -35,6 +37,15 @@ namespace cppsv {
             return view_type(this->string, this->string + N);
         }
 
+        static constexpr size_t chunk_count() noexcept {
+            return C;
+        }
+
+        // Get a single concatenated string, the last one includes the null terminator
+        constexpr auto chunk(size_t index) const noexcept {
+            return view_type(this->string + this->offsets[index], this->string + this->offsets[index + 1]);
+        }
+
         consteval cppsv_cat() = default;
 
         // Concatenate the contents of a tuple of csv strings in a single character array
@@ -42,8 +53,10 @@ namespace cppsv {
         template <size_t...Ns>
         consteval cppsv_cat(std::tuple<ref_array<CharT, Ns>...> tuple_chrs) noexcept {
             size_t offset = 0;
+            size_t index = 0;
             std::apply([&]<typename...Args>(Args&&...chrs) {
                 ([&]{
+                    this->offsets[index++] = offset;
                     if (!Ns || chrs[Ns - 1] != '\0')
                         no_null_terminator(); // Compile error: inputs are expected to be null terminated
                     if (!header_type::has_header(chrs))
@@ -52,16 +65,18 @@ namespace cppsv {
                     offset += Ns - header_type::size - 1;
                 }(), ...);
             }, tuple_chrs);
+            this->offsets[C] = N;
         }
 
         static void no_null_terminator() {}
         static void no_cppsv_header() {}
 
         CharT string[N]{};
+        size_t offsets[C + 1]{};
     };
 
     template <typename CharT, size_t...Ns> cppsv_cat(std::tuple<ref_array<CharT, Ns>...> strings)
-        -> cppsv_cat<CharT, (Ns + ...) - (cppsv_header<CharT>::size + 1) * sizeof...(Ns) + 1>;
+        -> cppsv_cat<CharT, (Ns + ...) - (cppsv_header<CharT>::size + 1) * sizeof...(Ns) + 1, sizeof...(Ns)>;
 
 
     // Helper class that represents a single field in a csv
@@ -118,12 +133,7 @@ namespace cppsv {
         // T can be constructed from an iterator range over the characters
         template <typename T>
         consteval T as() const noexcept {
-            if constexpr (std::is_integral_v<T>)
-                return to_integer(std::begin(this->string), std::end(this->string), T{}).value();
-            else if constexpr (std::is_floating_point_v<T>)
-                return to_floating_point(std::begin(this->string), std::end(this->string), T{}).value();
-            else
-                return T(std::begin(this->string), std::end(this->string));
+            return convert<T>(std::begin(this->string), std::end(this->string)).value();
         }
 
         static void no_null_terminator() {}
@@ -132,84 +142,109 @@ namespace cppsv {
     };
 
     // Main class, allows compile time comprehension of csv files
-    template <cppsv_cat Data>
+    // Options are applied while tokenizing (see parse_options)
+    template <cppsv_cat Data, parse_options Options = parse_options{}>
     struct cppsv_view {
         using view_type = typename decltype(Data)::view_type;
         using value_type = typename decltype(Data)::value_type;
     private:
         // Calculate column count (defined by the first row)
         static consteval size_t calc_x() noexcept {
-            // At least 1 column
-            size_t out = 1;
-            for (bool in_quotes = false; auto chr : Data.view()) {
-                in_quotes ^= chr == '"';
-                if (!in_quotes) {
-                    if (chr == ',') ++out;
-                    if (chr == '\n') break;
-                }
-            }
-            return out;
+            return count_columns(Options.chunk_headers ? Data.chunk(0) : Data.view(), Options);
         }
 
         // Calculate row count
         static consteval size_t calc_y() noexcept {
-            constexpr size_t x = calc_x();
-            size_t out = 1;
-            size_t index = 0;
-            for (bool in_quotes = false; auto chr : Data.view()) {
-                in_quotes ^= chr == '"';
-                if (!in_quotes) {
-                    if (chr == ',' && index < x)
-                        ++out, ++index;
-                    if (chr == '\n')
-                        ++out, index = 0;
-                }
+            if constexpr (Options.chunk_headers) {
+                // A single header row for all chunks
+                size_t out = 1;
+                for (size_t index = 0; index < Data.chunk_count(); ++index)
+                    out += count_rows(Data.chunk(index), calc_x(), Options) - 1;
+                return out;
             }
-            return out / x;
+            else return count_rows(Data.view(), calc_x(), Options);
         }
 
-        // Strip wrapping quotes, comma
-        static constexpr auto strip_field(view_type view) noexcept {
-            if (!view.empty() && (view.front() == ','))
-                view.remove_prefix(1);
-            if (view.length() > 1 && view.front() == '"' && view.back() == '"') {
-                view.remove_prefix(1);
-                view.remove_suffix(1);
+        // Map the columns of a chunk to the columns of the first chunk by name
+        static constexpr auto map_columns(view_type chunk) noexcept {
+            constexpr size_t x = calc_x();
+            if (count_columns(chunk, Options) != x)
+                schema_column_count_mismatch(); // Compile error: chunks must have the same number of columns
+            std::array<view_type, x> names{};
+            std::array<view_type, x> chunk_names{};
+            tokenize(Data.chunk(0), x, Options, [&](size_t index_x, size_t index_y, view_type field) {
+                if (!index_y) names[index_x] = field;
+            });
+            tokenize(chunk, x, Options, [&](size_t index_x, size_t index_y, view_type field) {
+                if (!index_y) chunk_names[index_x] = field;
+            });
+            std::array<size_t, x> out{};
+            std::array<bool, x> mapped{};
+            for (size_t index = 0; index < x; ++index) {
+                size_t target = std::find(names.begin(), names.end(), chunk_names[index]) - names.begin();
+                if (target == x)
+                    schema_column_not_found(); // Compile error: chunk column is not in the first chunk
+                if (mapped[target])
+                    schema_duplicate_column(); // Compile error: chunk column appears more than once
+                mapped[target] = true;
+                out[index] = target;
             }
-            return view;
+            return out;
         }
-        
+
+        static void schema_column_count_mismatch() {}
+        static void schema_column_not_found() {}
+        static void schema_duplicate_column() {}
+
         // A 2D array of string views of each field in the csv
         // Is not exposed - it can be iterated over, but individual entries are never returned
-        static constexpr auto fields = []() {
+        static constexpr auto fields = []() consteval {
             constexpr size_t x = calc_x();
             constexpr size_t y = calc_y();
             std::array<std::array<view_type, x>, y> out{};
-            auto first = Data.view().begin();
-            auto last = Data.view().end();
-            auto field_first = first;
-            size_t index_x = 0;
-            size_t index_y = 0;
-            for (bool in_quotes = false; first != last; ++first) {
-                auto chr = *first;
-                in_quotes ^= chr == '"';
-                if (!in_quotes) {
-                    if ((chr == ',' || chr == '\n') && index_x < x) {
-                        out[index_y][index_x++] = strip_field({ field_first, first });
-                        field_first = first != last ? first + 1 : first;
-                    }
-                    if (chr == '\n') {
-                        index_x = 0;
-                        ++index_y;
-                    }
+            if constexpr (Options.chunk_headers) {
+                // Fields of every chunk are placed in the columns of the first chunk,
+                // the header rows of the other chunks are dropped
+                size_t first_row = 0;
+                for (size_t index = 0; index < Data.chunk_count(); ++index) {
+                    auto chunk = Data.chunk(index);
+                    auto columns = map_columns(chunk);
+                    size_t rows = count_rows(chunk, x, Options);
+                    size_t skip = index ? 1 : 0;
+                    tokenize(chunk, x, Options, [&](size_t index_x, size_t index_y, view_type field) {
+                        if (index_y >= skip && index_y < rows)
+                            out[first_row + index_y - skip][columns[index_x]] = field;
+                    });
+                    first_row += rows - skip;
                 }
             }
+            else {
+                tokenize(Data.view(), x, Options, [&](size_t index_x, size_t index_y, view_type field) {
+                    out[index_y][index_x] = field;
+                });
+            }
             return out;
         }();
 
     public:
         constexpr cppsv_view() = default;
 
+        // Get the options the csv was tokenized with
+        static consteval parse_options options() noexcept {
+            return Options;
+        }
+
+        // Get the field table, for access to the csv at runtime (see runtime_cppsv_view::from_embedded)
+        // Unlike the immediate functions, calling this at runtime embeds the table and the csv in the binary
+        static constexpr const auto& embedded_fields() noexcept {
+            return fields;
+        }
+
+        // Get the concatenated csv all embedded fields point into
+        static constexpr view_type embedded_buffer() noexcept {
+            return Data.view();
+        }
+
         // Get the column count in the csv
         // The column count is defined by the number of fields in the first row
         static consteval size_t columns() noexcept {
@@ -226,7 +261,7 @@ namespace cppsv {
         static consteval auto get_row() noexcept {
             static_assert(IRow < rows(), "row index out of bounds");
             constexpr auto row = std::get<IRow>(fields);
-            return [&]<size_t...Xs>(std::index_sequence<Xs...>) {
+            return [&]<size_t...Xs>(std::index_sequence<Xs...>) consteval {
                 return std::tuple{ cppsv_field<value_type, std::get<Xs>(row).size() + 1>(
                     std::get<Xs>(row))... };
             }(std::make_index_sequence<columns()>{});
@@ -259,7 +294,7 @@ namespace cppsv {
         // Get a field from a tuple-like csv row by column name
         template <cppsv_field ColumnName>
         static consteval auto get_field(const auto& row) noexcept {
-            constexpr size_t index = [&]{
+            constexpr size_t index = [&]() consteval {
                 size_t result = 0;
                 for (const auto& field : std::get<0>(fields)) {
                     if (!field.compare(ColumnName.c_str())) break;
@@ -292,7 +327,7 @@ namespace cppsv {
         // while "function(std::basic_string_view<value_type>)" evaluates to "true"
         // Accepts only constant evaluated functions, returns the field or empty
         static consteval auto find_field(auto function) noexcept {
-            constexpr auto field = [&]{
+            constexpr auto field = [&]() consteval {
                 for (const auto& row : fields) 
                     for (const auto& field : row)
                         if (function(field)) return field;
@@ -310,7 +345,7 @@ namespace cppsv {
 
         template <size_t...I>
         static consteval auto _find_row(auto function, std::index_sequence<I...>) noexcept {
-            constexpr auto row = [&]{
+            constexpr auto row = [&]() consteval {
                 for (const auto& row : fields) 
                     if (function(row)) return row;
                 return std::array<view_type, columns()>{};
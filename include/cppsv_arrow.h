@@ -0,0 +1,280 @@
+#ifndef CPPSV_INCLUDE_CPPSV_ARROW_H
+#define CPPSV_INCLUDE_CPPSV_ARROW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+#include "cppsv_rt.h"
+#include "bitmap.h"
+
+// Arrow C data interface structures, as specified by
+// https://arrow.apache.org/docs/format/CDataInterface.html
+// The guard matches the one used by Arrow, so both definitions can coexist
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+    struct ArrowSchema {
+        const char* format;
+        const char* name;
+        const char* metadata;
+        int64_t flags;
+        int64_t n_children;
+        struct ArrowSchema** children;
+        struct ArrowSchema* dictionary;
+        void (*release)(struct ArrowSchema*);
+        void* private_data;
+    };
+
+    struct ArrowArray {
+        int64_t length;
+        int64_t null_count;
+        int64_t offset;
+        int64_t n_buffers;
+        int64_t n_children;
+        const void** buffers;
+        struct ArrowArray** children;
+        struct ArrowArray* dictionary;
+        void (*release)(struct ArrowArray*);
+        void* private_data;
+    };
+}
+
+#endif /* ARROW_C_DATA_INTERFACE */
+
+namespace cppsv {
+    // Storage owned by an exported ArrowArray, freed by its release callback
+    struct arrow_array_data {
+        std::vector<std::shared_ptr<const void>> owned;
+        std::vector<const void*> buffers;
+        std::vector<ArrowArray> child_storage;
+        std::vector<ArrowArray*> children;
+
+        // Take ownership of a container and return a pointer to its elements
+        template <typename Container>
+        const void* own(Container&& container) {
+            auto owned = std::make_shared<std::decay_t<Container>>(std::forward<Container>(container));
+            const void* out = owned->data();
+            this->owned.push_back(std::move(owned));
+            return out;
+        }
+
+        static void release(ArrowArray* array) noexcept {
+            auto* data = static_cast<arrow_array_data*>(array->private_data);
+            for (auto& child : data->child_storage)
+                if (child.release) child.release(&child);
+            delete data;
+            array->release = nullptr;
+        }
+
+        // Fill in an array with this storage as its private data
+        void export_to(ArrowArray* out, int64_t length, int64_t null_count) && {
+            auto* data = new arrow_array_data(std::move(*this));
+            for (auto& child : data->child_storage)
+                data->children.push_back(&child);
+            *out = ArrowArray{
+                length, null_count, 0,
+                static_cast<int64_t>(data->buffers.size()), static_cast<int64_t>(data->children.size()),
+                data->buffers.data(), data->children.empty() ? nullptr : data->children.data(),
+                nullptr, &arrow_array_data::release, data
+            };
+        }
+    };
+
+    // Storage owned by an exported ArrowSchema, freed by its release callback
+    struct arrow_schema_data {
+        std::string format;
+        std::string name;
+        std::vector<ArrowSchema> child_storage;
+        std::vector<ArrowSchema*> children;
+
+        static void release(ArrowSchema* schema) noexcept {
+            auto* data = static_cast<arrow_schema_data*>(schema->private_data);
+            for (auto& child : data->child_storage)
+                if (child.release) child.release(&child);
+            delete data;
+            schema->release = nullptr;
+        }
+
+        void export_to(ArrowSchema* out, int64_t flags) && {
+            auto* data = new arrow_schema_data(std::move(*this));
+            for (auto& child : data->child_storage)
+                data->children.push_back(&child);
+            *out = ArrowSchema{
+                data->format.c_str(), data->name.c_str(), nullptr, flags,
+                static_cast<int64_t>(data->children.size()), data->children.empty() ? nullptr : data->children.data(),
+                nullptr, &arrow_schema_data::release, data
+            };
+        }
+    };
+
+    // Get the Arrow format string of a column type
+    template <typename T>
+    inline std::string arrow_format() {
+        if constexpr (std::is_same_v<T, bool>) return "b";
+        else if constexpr (std::is_same_v<T, std::chrono::sys_days>) return "tdD";
+        else if constexpr (std::is_same_v<T, std::chrono::sys_seconds>) return "tss:";
+        else if constexpr (is_decimal_v<T>) return "d:19," + std::to_string(T::scale);
+        else if constexpr (std::is_integral_v<T>) {
+            constexpr const char* formats[2][4]{ { "C", "S", "I", "L" }, { "c", "s", "i", "l" } };
+            return formats[std::is_signed_v<T>][std::countr_zero(sizeof(T))];
+        }
+        else if constexpr (std::is_same_v<T, float>) return "f";
+        else if constexpr (std::is_same_v<T, double>) return "g";
+        else static_assert(!sizeof(T), "type has no Arrow representation");
+    }
+
+    // Convert column values to the Arrow physical layout, moving them where it is the same
+    template <typename T>
+    inline const void* arrow_values(arrow_array_data& data, std::vector<T>&& values) {
+        if constexpr (std::is_same_v<T, bool>) {
+            // Bits are stored in 64-bit words, which match the Arrow byte order on little endian targets only
+            static_assert(std::endian::native == std::endian::little, "bitmap layout differs from Arrow");
+            auto bits = bitmap(values.size());
+            for (size_t index = 0; index < values.size(); ++index)
+                bits.set(index, values[index]);
+            return data.own(std::move(bits.data()));
+        }
+        else if constexpr (std::is_same_v<T, std::chrono::sys_days>) {
+            // date32, days since the epoch
+            auto days = std::vector<int32_t>(values.size());
+            for (size_t index = 0; index < values.size(); ++index)
+                days[index] = static_cast<int32_t>(values[index].time_since_epoch().count());
+            return data.own(std::move(days));
+        }
+        else if constexpr (is_decimal_v<T>) {
+            // decimal128, little endian two's complement with the low word first
+            static_assert(std::endian::native == std::endian::little, "decimal128 layout differs from Arrow");
+            auto words = std::vector<int64_t>(values.size() * 2);
+            for (size_t index = 0; index < values.size(); ++index) {
+                words[index * 2] = values[index].value;
+                words[index * 2 + 1] = values[index].value < 0 ? -1 : 0;
+            }
+            return data.own(std::move(words));
+        }
+        else if constexpr (std::is_same_v<T, std::chrono::sys_seconds>) {
+            // timestamp[s], same layout as the underlying 64-bit count
+            static_assert(sizeof(T) == sizeof(int64_t));
+            return data.own(std::move(values));
+        }
+        else {
+            static_assert(std::is_arithmetic_v<T>, "type has no Arrow representation");
+            return data.own(std::move(values));
+        }
+    }
+
+    // Export a typed column as an Arrow array and schema
+    // The values are moved into the array, which owns them until released
+    template <typename T>
+    inline void export_column(std::vector<T>&& values, const std::string& name,
+        ArrowArray* out_array, ArrowSchema* out_schema) {
+        auto length = static_cast<int64_t>(values.size());
+        arrow_array_data data;
+        data.buffers = { nullptr, nullptr };
+        data.buffers[1] = arrow_values(data, std::move(values));
+        std::move(data).export_to(out_array, length, 0);
+        arrow_schema_data{ arrow_format<T>(), name, {}, {} }.export_to(out_schema, 0);
+    }
+
+    // Export a typed column with missing values as an Arrow array and schema
+    // The values and validity bitmap are moved into the array, which owns them until released
+    // The validity bitmap layout matches Arrow on little endian targets only
+    template <typename T>
+    inline void export_column(nullable_column<T>&& column, const std::string& name,
+        ArrowArray* out_array, ArrowSchema* out_schema) {
+        static_assert(std::endian::native == std::endian::little, "bitmap layout differs from Arrow");
+        auto length = static_cast<int64_t>(column.values.size());
+        auto null_count = static_cast<int64_t>(column.null_count());
+        arrow_array_data data;
+        data.buffers = { nullptr, nullptr };
+        if (null_count) data.buffers[0] = data.own(std::move(column.validity.data()));
+        data.buffers[1] = arrow_values(data, std::move(column.values));
+        std::move(data).export_to(out_array, length, null_count);
+        arrow_schema_data{ arrow_format<T>(), name, {}, {} }.export_to(out_schema, ARROW_FLAG_NULLABLE);
+    }
+
+    // Export a column of a runtime view as an Arrow utf8 view array ("vu") and schema,
+    // one value per row after the header row
+    // Strings are not copied: longer strings reference the csv buffer of the view,
+    // which must outlive the array
+    // Fields matching "nulls" (a combination of null_format flags) are exported as missing
+    template <typename CharT>
+    inline void export_string_column(const runtime_cppsv_view<CharT>& view, size_t column_index,
+        const std::string& name, ArrowArray* out_array, ArrowSchema* out_schema, unsigned int nulls = 0) {
+        static_assert(sizeof(CharT) == 1, "Arrow strings are byte strings");
+        // Views address data buffers with 32-bit offsets, so the csv buffer is exposed
+        // as overlapping windows: a string starting in window i fits entirely in it
+        constexpr size_t window_step = size_t{ 1 } << 30;
+        constexpr size_t window_size = size_t{ 1 } << 31;
+        struct string_view_entry {
+            int32_t length;
+            unsigned char prefix[4];
+            int32_t buffer_index;
+            int32_t offset;
+        };
+        static_assert(sizeof(string_view_entry) == 16);
+        auto buffer = view.buffer();
+        size_t length = view.rows() ? view.rows() - 1 : 0;
+        auto entries = std::vector<string_view_entry>(length);
+        auto validity = bitmap(length, true);
+        for (size_t index = 0; index < length; ++index) {
+            const auto& field = view.get_row(index + 1).at(column_index);
+            auto& entry = entries[index];
+            entry.length = static_cast<int32_t>(field.size());
+            if (nulls && is_null(field.begin(), field.end(), nulls)) {
+                validity.set(index, false);
+                entry.length = 0;
+            }
+            else if (field.size() <= 12) {
+                // Short strings are stored inline, over the prefix and the following fields
+                std::memcpy(reinterpret_cast<unsigned char*>(&entry) + 4, field.data(), field.size());
+            }
+            else {
+                size_t offset = field.data() - buffer.data();
+                std::memcpy(entry.prefix, field.data(), 4);
+                entry.buffer_index = static_cast<int32_t>(offset / window_step);
+                entry.offset = static_cast<int32_t>(offset % window_step);
+            }
+        }
+        auto window_sizes = std::vector<int64_t>();
+        for (size_t first = 0; first < buffer.size() || window_sizes.empty(); first += window_step)
+            window_sizes.push_back(static_cast<int64_t>(std::min(window_size, buffer.size() - first)));
+        auto null_count = static_cast<int64_t>(length - validity.count());
+        arrow_array_data data;
+        data.buffers.push_back(null_count ? data.own(std::move(validity.data())) : nullptr);
+        data.buffers.push_back(data.own(std::move(entries)));
+        for (size_t window = 0; window < window_sizes.size(); ++window)
+            data.buffers.push_back(buffer.data() + window * window_step);
+        data.buffers.push_back(data.own(std::move(window_sizes)));
+        std::move(data).export_to(out_array, static_cast<int64_t>(length), null_count);
+        arrow_schema_data{ "vu", name, {}, {} }.export_to(out_schema, nulls ? ARROW_FLAG_NULLABLE : 0);
+    }
+
+    // Combine exported columns of equal length into a record batch (a struct array)
+    // Takes ownership of the columns, which are released together with the batch
+    inline void export_record_batch(std::vector<ArrowArray>&& arrays, std::vector<ArrowSchema>&& schemas,
+        ArrowArray* out_array, ArrowSchema* out_schema) {
+        int64_t length = arrays.empty() ? 0 : arrays.front().length;
+        arrow_array_data data;
+        data.buffers = { nullptr };
+        data.child_storage = std::move(arrays);
+        std::move(data).export_to(out_array, length, 0);
+        arrow_schema_data schema{ "+s", "", {}, {} };
+        schema.child_storage = std::move(schemas);
+        std::move(schema).export_to(out_schema, 0);
+    }
+}
+
+#endif /* CPPSV_INCLUDE_CPPSV_ARROW_H */
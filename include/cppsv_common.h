@@ -3,9 +3,16 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string_view>
 #include <algorithm>
 #include <iterator>
 
+// SSE2 is used for runtime-only fast paths when available,
+// define CPPSV_NO_SIMD to always use the portable implementations
+#if !defined(CPPSV_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CPPSV_SSE2
+#endif
+
 namespace cppsv {
     // Standard cppsv csv header
     // It is validated before parsing the csv string
@@ -21,6 +28,149 @@ namespace cppsv {
                 && std::equal(std::begin(value), std::end(value), begin);
         }
     };
+
+    // Characters trimmed from both ends of fields while tokenizing,
+    // each policy includes the previous ones
+    enum class trim_policy {
+        none,
+        spaces,    // ' '
+        tabs,      // ' ', '\t'
+        whitespace // ' ', '\t', '\n', '\v', '\f', '\r'
+    };
+
+    // Options applied while recording field boundaries
+    struct parse_options {
+        trim_policy trim = trim_policy::none;
+        // Lines starting with any of these characters are skipped, e.g. "#"
+        char comment[4]{};
+        // Skip lines that are empty or contain only spaces, tabs and carriage returns
+        bool skip_blank_lines = false;
+        // Compile time views only: every concatenated csv string starts with its own header row,
+        // columns are matched by name to the first one and reordered accordingly
+        bool chunk_headers = false;
+    };
+
+    template <typename CharT>
+    inline constexpr bool is_trimmed(CharT chr, trim_policy trim) noexcept {
+        switch (trim) {
+        case trim_policy::none:
+            return false;
+        case trim_policy::spaces:
+            return chr == ' ';
+        case trim_policy::tabs:
+            return chr == ' ' || chr == '\t';
+        default:
+            return chr == ' ' || (chr >= '\t' && chr <= '\r');
+        }
+    }
+
+    // Skip comment and blank lines (per the options) starting at "first", which is the start of a line
+    // Returns the start of the next line that is not skipped
+    template <typename It>
+    inline constexpr It skip_lines(It first, It last, const parse_options& options) noexcept {
+        if (!options.comment[0] && !options.skip_blank_lines) return first;
+        while (first != last) {
+            bool comment = false;
+            for (auto prefix : options.comment)
+                comment |= prefix != '\0' && *first == prefix;
+            auto line_last = first;
+            if (comment)
+                line_last = std::find(first, last, '\n');
+            else if (options.skip_blank_lines) {
+                // The null terminator ends compile time data
+                while (line_last != last && (*line_last == ' ' || *line_last == '\t'
+                    || *line_last == '\r' || *line_last == '\0'))
+                    ++line_last;
+                if (line_last != last && *line_last != '\n') break;
+            }
+            else break;
+            first = line_last != last ? line_last + 1 : last;
+        }
+        return first;
+    }
+
+    // Calculate column count (defined by the first row)
+    template <typename CharT>
+    inline constexpr size_t count_columns(std::basic_string_view<CharT> data, const parse_options& options = {}) noexcept {
+        // At least 1 column
+        size_t out = 1;
+        auto last = data.end();
+        for (bool in_quotes = false; auto chr : std::basic_string_view<CharT>(skip_lines(data.begin(), last, options), last)) {
+            in_quotes ^= chr == '"';
+            if (!in_quotes) {
+                if (chr == ',') ++out;
+                if (chr == '\n') break;
+            }
+        }
+        return out;
+    }
+
+    // Calculate row count
+    template <typename CharT>
+    inline constexpr size_t count_rows(std::basic_string_view<CharT> data, size_t x, const parse_options& options = {}) noexcept {
+        size_t out = 1;
+        size_t index = 0;
+        auto last = data.end();
+        bool in_quotes = false;
+        for (auto first = skip_lines(data.begin(), last, options); first != last; ++first) {
+            auto chr = *first;
+            in_quotes ^= chr == '"';
+            if (!in_quotes) {
+                if (chr == ',' && index < x)
+                    ++out, ++index;
+                if (chr == '\n') {
+                    ++out, index = 0;
+                    first = skip_lines(first + 1, last, options) - 1;
+                }
+            }
+        }
+        return out / x;
+    }
+
+    // Strip comma, surrounding whitespace (per the trimming policy), wrapping quotes
+    template <typename CharT>
+    inline constexpr auto strip_field(std::basic_string_view<CharT> view, trim_policy trim) noexcept {
+        if (!view.empty() && (view.front() == ','))
+            view.remove_prefix(1);
+        while (!view.empty() && is_trimmed(view.front(), trim))
+            view.remove_prefix(1);
+        while (!view.empty() && is_trimmed(view.back(), trim))
+            view.remove_suffix(1);
+        if (view.length() > 1 && view.front() == '"' && view.back() == '"') {
+            view.remove_prefix(1);
+            view.remove_suffix(1);
+        }
+        return view;
+    }
+
+    // Split csv data into the first x fields of each row,
+    // calling "function(size_t index_x, size_t index_y, std::basic_string_view<CharT>)"
+    // Shared by the compile time and runtime views
+    template <typename CharT>
+    inline constexpr void tokenize(std::basic_string_view<CharT> data, size_t x,
+        parse_options options, auto function) noexcept {
+        auto last = data.end();
+        auto first = skip_lines(data.begin(), last, options);
+        auto field_first = first;
+        size_t index_x = 0;
+        size_t index_y = 0;
+        for (bool in_quotes = false; first != last; ++first) {
+            auto chr = *first;
+            in_quotes ^= chr == '"';
+            if (!in_quotes) {
+                if ((chr == ',' || chr == '\n') && index_x < x) {
+                    function(index_x++, index_y, strip_field<CharT>({ field_first, first }, options.trim));
+                    field_first = first != last ? first + 1 : first;
+                }
+                if (chr == '\n') {
+                    index_x = 0;
+                    ++index_y;
+                    first = skip_lines(first + 1, last, options) - 1;
+                    field_first = first + 1;
+                }
+            }
+        }
+    }
 }
 
 #endif /* CPPSV_INCLUDE_CPPSV_COMMON_H */
\ No newline at end of file
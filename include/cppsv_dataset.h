@@ -0,0 +1,260 @@
+#ifndef CPPSV_INCLUDE_CPPSV_DATASET_H
+#define CPPSV_INCLUDE_CPPSV_DATASET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+
+#include "cppsv_rt.h"
+#include "parallel.h"
+
+namespace cppsv {
+    // Match a file name against a pattern with '*' (any run of characters) and '?' (any character)
+    inline constexpr bool match_wildcard(std::string_view pattern, std::string_view name) noexcept {
+        size_t pattern_index = 0;
+        size_t name_index = 0;
+        // Position after the last '*' and the name position it was matched up to, for backtracking
+        size_t star_index = std::string_view::npos;
+        size_t star_name_index = 0;
+        while (name_index < name.size()) {
+            if (pattern_index < pattern.size()
+                && (pattern[pattern_index] == '?' || pattern[pattern_index] == name[name_index])) {
+                ++pattern_index;
+                ++name_index;
+            }
+            else if (pattern_index < pattern.size() && pattern[pattern_index] == '*') {
+                star_index = ++pattern_index;
+                star_name_index = name_index;
+            }
+            else if (star_index != std::string_view::npos) {
+                pattern_index = star_index;
+                name_index = ++star_name_index;
+            }
+            else return false;
+        }
+        while (pattern_index < pattern.size() && pattern[pattern_index] == '*')
+            ++pattern_index;
+        return pattern_index == pattern.size();
+    }
+
+    // Get the regular files matching a pattern, sorted by path
+    // Wildcards are only supported in the file name, e.g. "exports/day-*.csv"
+    inline std::vector<std::filesystem::path> glob_files(const std::filesystem::path& pattern) {
+        auto out = std::vector<std::filesystem::path>();
+        auto directory = pattern.has_parent_path() ? pattern.parent_path() : std::filesystem::path(".");
+        auto name_pattern = pattern.filename().string();
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            if (entry.is_regular_file(error) && match_wildcard(name_pattern, entry.path().filename().string()))
+                out.push_back(entry.path());
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    // Read the contents of a file, or empty if it cannot be read
+    template <typename CharT>
+    inline std::optional<std::basic_string<CharT>> read_file(const std::filesystem::path& path) {
+        auto file = std::ifstream(path, std::ios::binary | std::ios::ate);
+        if (!file) return std::nullopt;
+        auto size = static_cast<size_t>(file.tellg());
+        auto out = std::basic_string<CharT>(size / sizeof(CharT), CharT{});
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(out.data()), out.size() * sizeof(CharT)))
+            return std::nullopt;
+        return out;
+    }
+
+    // A runtime csv view over many csv files (shards) with the same header row,
+    // presented as one logical range of rows
+    // Rows are numbered globally: row 0 is the header row, followed by the data rows
+    // of every shard in order
+    // Shards are loaded and indexed in parallel on construction
+    // A dataset that is not valid() has no columns and no rows to visit or select,
+    // only its shards and row counts can be inspected
+    template <typename CharT>
+    class dataset_view {
+    public:
+        using view_type = std::basic_string_view<CharT>;
+        using value_type = CharT;
+        using shard_view_type = runtime_cppsv_view<CharT>;
+    private:
+        std::vector<std::unique_ptr<shard_view_type>> shards;
+        // Global row index of the first data row of each shard, followed by the row count
+        std::vector<size_t> first_rows;
+        bool consistent = false;
+
+        dataset_view() = default;
+
+        // Check the shards and number their rows
+        // Shards that were not loaded, are empty or have another header row contribute no rows
+        void index_rows() noexcept {
+            auto loaded = [](const auto& shard) { return shard && shard->rows(); };
+            // Compare header rows to the first loaded shard, any shard may be missing
+            auto reference = std::find_if(this->shards.begin(), this->shards.end(), loaded);
+            this->consistent = !this->shards.empty();
+            this->first_rows.assign(1, 1);
+            for (const auto& shard : this->shards) {
+                if (!loaded(shard) || shard->get_row(0) != (*reference)->get_row(0)) {
+                    this->consistent = false;
+                    this->first_rows.push_back(this->first_rows.back());
+                    continue;
+                }
+                this->first_rows.push_back(this->first_rows.back() + shard->rows() - 1);
+            }
+        }
+
+    public:
+        // Load and index csv files, using up to "threads" threads (0 uses the hardware concurrency)
+        // Options are applied while tokenizing each file (see parse_options)
+        explicit dataset_view(const std::vector<std::filesystem::path>& paths,
+            parse_options options = {}, size_t threads = 0)
+            : shards(paths.size()) {
+            parallel_for(paths.size(), threads, [&](size_t index) {
+                auto data = read_file<CharT>(paths[index]);
+                if (data) this->shards[index] = std::make_unique<shard_view_type>(std::move(data.value()), options);
+            });
+            this->index_rows();
+        }
+
+        // Index csv data already in memory, one buffer per shard
+        static dataset_view from_buffers(std::vector<std::basic_string<CharT>> buffers,
+            parse_options options = {}, size_t threads = 0) {
+            auto out = dataset_view();
+            out.shards.resize(buffers.size());
+            parallel_for(buffers.size(), threads, [&](size_t index) {
+                out.shards[index] = std::make_unique<shard_view_type>(std::move(buffers[index]), options);
+            });
+            out.index_rows();
+            return out;
+        }
+
+        // Check if every shard was loaded and has the header row of the first shard
+        bool valid() const noexcept {
+            return this->consistent;
+        }
+
+        size_t shard_count() const noexcept {
+            return this->shards.size();
+        }
+
+        // Get the view of a single shard, row 0 of every shard is the header row
+        // Returns nullptr if the shard could not be loaded
+        const shard_view_type* get_shard(size_t shard_index) const noexcept {
+            return this->shards.at(shard_index).get();
+        }
+
+        // Get the column count in the csv, 0 if the dataset is not valid
+        size_t columns() const noexcept {
+            if (!this->valid()) return 0;
+            return this->shards[0]->columns();
+        }
+
+        // Get the row count of all shards, including a single header row
+        size_t rows() const noexcept {
+            return this->first_rows.back();
+        }
+
+        // Find the shard containing a global row index (row 0 is the header row)
+        // Returns the shard index and the row index within that shard,
+        // or empty if the row is out of bounds
+        std::optional<std::pair<size_t, size_t>> find_shard(size_t row_index) const noexcept {
+            if (!row_index) return std::pair<size_t, size_t>{ 0, 0 };
+            if (row_index >= this->rows()) return std::nullopt;
+            // Empty shards share their first row with the next shard, take the last one
+            size_t shard_index = std::upper_bound(this->first_rows.begin(), this->first_rows.end() - 1, row_index)
+                - this->first_rows.begin() - 1;
+            return std::pair{ shard_index, row_index - this->first_rows[shard_index] + 1 };
+        }
+
+        // Get a csv row by the global row index as a vector of fields
+        // Throws std::out_of_range if the row is out of bounds or the dataset is not valid
+        const auto& get_row(size_t row_index) const {
+            auto location = this->find_shard(row_index);
+            if (!location || !this->valid()) throw std::out_of_range("dataset_view::get_row");
+            return this->shards[location->first]->get_row(location->second);
+        }
+
+        // Get a csv field by the column name and global row index
+        const auto& get_field(const auto& column_name, size_t row_index) const {
+            const auto& row = this->get_row(row_index);
+            return this->shards[0]->get_field(row, column_name);
+        }
+
+        // Iterate over all rows of all shards (the header row is visited once),
+        // calling "function(std::vector<std::basic_string_view<value_type>>)"
+        void for_each_row(auto function) const noexcept {
+            if (!this->valid()) return;
+            for (size_t shard_index = 0; shard_index < this->shard_count(); ++shard_index) {
+                const auto& shard = *this->shards[shard_index];
+                for (size_t row_index = shard_index ? 1 : 0; row_index < shard.rows(); ++row_index)
+                    function(shard.get_row(row_index));
+            }
+        }
+
+        // Iterate over all rows
+        // while "function(std::vector<std::basic_string_view<value_type>>)" evaluates to "true"
+        // Returns the global row index or empty
+        std::optional<size_t> find_row_index(auto function) const noexcept {
+            if (!this->valid()) return std::nullopt;
+            for (size_t shard_index = 0; shard_index < this->shard_count(); ++shard_index) {
+                const auto& shard = *this->shards[shard_index];
+                for (size_t row_index = shard_index ? 1 : 0; row_index < shard.rows(); ++row_index)
+                    if (function(shard.get_row(row_index)))
+                        return row_index ? this->first_rows[shard_index] + row_index - 1 : 0;
+            }
+            return std::nullopt;
+        }
+
+        // Select all rows after the header row
+        // for which "function(std::vector<std::basic_string_view<value_type>>)" evaluates to "true",
+        // scanning shards on up to "threads" threads (0 uses the hardware concurrency)
+        // The function may be called concurrently from different threads
+        // Returns global row indices in ascending order
+        std::vector<size_t> select_rows(auto function, size_t threads = 0) const {
+            if (!this->valid()) return {};
+            auto selected = std::vector<std::vector<size_t>>(this->shard_count());
+            parallel_for(this->shard_count(), threads, [&](size_t shard_index) {
+                const auto& shard = *this->shards[shard_index];
+                for (size_t row_index = 1; row_index < shard.rows(); ++row_index)
+                    if (function(shard.get_row(row_index)))
+                        selected[shard_index].push_back(this->first_rows[shard_index] + row_index - 1);
+            });
+            auto out = std::vector<size_t>();
+            for (const auto& indices : selected)
+                out.insert(out.end(), indices.begin(), indices.end());
+            return out;
+        }
+
+        // Convert a column of all shards to a vector of values, one per data row,
+        // converting shards on up to "threads" threads (0 uses the hardware concurrency)
+        // Returns empty if any field cannot be converted or the dataset is not valid
+        template <typename T, number_format Format = number_format{}>
+        std::optional<std::vector<T>> get_column(size_t column_index, size_t threads = 0) const {
+            if (!this->valid()) return std::nullopt;
+            auto columns = std::vector<std::optional<std::vector<T>>>(this->shard_count());
+            parallel_for(this->shard_count(), threads, [&](size_t shard_index) {
+                columns[shard_index] = this->shards[shard_index]->template get_column<T, Format>(column_index);
+            });
+            auto out = std::vector<T>();
+            out.reserve(this->rows() - 1);
+            for (auto& column : columns) {
+                if (!column) return std::nullopt;
+                std::move(column->begin(), column->end(), std::back_inserter(out));
+            }
+            return out;
+        }
+    };
+}
+
+#endif /* CPPSV_INCLUDE_CPPSV_DATASET_H */
@@ -0,0 +1,202 @@
+#ifndef CPPSV_INCLUDE_CPPSV_FILTER_H
+#define CPPSV_INCLUDE_CPPSV_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "cppsv_common.h"
+#include "cppsv_rt.h"
+#include "bitmap.h"
+
+#ifdef CPPSV_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace cppsv {
+    enum class compare_op {
+        equal,
+        not_equal,
+        less,
+        less_equal,
+        greater,
+        greater_equal
+    };
+
+    template <compare_op Op, typename T>
+    inline constexpr bool compare(const T& lhs, const T& rhs) noexcept {
+        if constexpr (Op == compare_op::equal) return lhs == rhs;
+        else if constexpr (Op == compare_op::not_equal) return lhs != rhs;
+        else if constexpr (Op == compare_op::less) return lhs < rhs;
+        else if constexpr (Op == compare_op::less_equal) return lhs <= rhs;
+        else if constexpr (Op == compare_op::greater) return lhs > rhs;
+        else return lhs >= rhs;
+    }
+
+    // Compare up to 64 values against a constant,
+    // returning the results as bits of a word (value i at bit i)
+    template <compare_op Op, typename T>
+    inline uint64_t compare_block(const T* values, size_t count, const T& value) noexcept {
+#ifdef CPPSV_SSE2
+        if (count == 64) {
+            if constexpr (std::is_same_v<T, double>) {
+                uint64_t out = 0;
+                __m128d rhs = _mm_set1_pd(value);
+                for (size_t index = 0; index < 64; index += 2) {
+                    __m128d lhs = _mm_loadu_pd(values + index);
+                    __m128d mask;
+                    if constexpr (Op == compare_op::equal) mask = _mm_cmpeq_pd(lhs, rhs);
+                    else if constexpr (Op == compare_op::not_equal) mask = _mm_cmpneq_pd(lhs, rhs);
+                    else if constexpr (Op == compare_op::less) mask = _mm_cmplt_pd(lhs, rhs);
+                    else if constexpr (Op == compare_op::less_equal) mask = _mm_cmple_pd(lhs, rhs);
+                    else if constexpr (Op == compare_op::greater) mask = _mm_cmpgt_pd(lhs, rhs);
+                    else mask = _mm_cmpge_pd(lhs, rhs);
+                    out |= static_cast<uint64_t>(_mm_movemask_pd(mask)) << index;
+                }
+                return out;
+            }
+            else if constexpr (std::is_same_v<T, float>) {
+                uint64_t out = 0;
+                __m128 rhs = _mm_set1_ps(value);
+                for (size_t index = 0; index < 64; index += 4) {
+                    __m128 lhs = _mm_loadu_ps(values + index);
+                    __m128 mask;
+                    if constexpr (Op == compare_op::equal) mask = _mm_cmpeq_ps(lhs, rhs);
+                    else if constexpr (Op == compare_op::not_equal) mask = _mm_cmpneq_ps(lhs, rhs);
+                    else if constexpr (Op == compare_op::less) mask = _mm_cmplt_ps(lhs, rhs);
+                    else if constexpr (Op == compare_op::less_equal) mask = _mm_cmple_ps(lhs, rhs);
+                    else if constexpr (Op == compare_op::greater) mask = _mm_cmpgt_ps(lhs, rhs);
+                    else mask = _mm_cmpge_ps(lhs, rhs);
+                    out |= static_cast<uint64_t>(_mm_movemask_ps(mask)) << index;
+                }
+                return out;
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4) {
+                uint64_t out = 0;
+                __m128i rhs = _mm_set1_epi32(value);
+                for (size_t index = 0; index < 64; index += 4) {
+                    __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + index));
+                    // SSE2 only has == and >, the rest are derived by swapping and negating
+                    __m128i mask;
+                    if constexpr (Op == compare_op::equal || Op == compare_op::not_equal)
+                        mask = _mm_cmpeq_epi32(lhs, rhs);
+                    else if constexpr (Op == compare_op::greater || Op == compare_op::less_equal)
+                        mask = _mm_cmpgt_epi32(lhs, rhs);
+                    else
+                        mask = _mm_cmpgt_epi32(rhs, lhs);
+                    uint64_t bits = _mm_movemask_ps(_mm_castsi128_ps(mask));
+                    if constexpr (Op == compare_op::not_equal || Op == compare_op::less_equal
+                        || Op == compare_op::greater_equal)
+                        bits ^= 0xF;
+                    out |= bits << index;
+                }
+                return out;
+            }
+        }
+#endif
+        // Branch free fallback, suitable for auto-vectorization
+        uint64_t out = 0;
+        for (size_t index = 0; index < count; ++index)
+            out |= static_cast<uint64_t>(compare<Op>(values[index], value)) << index;
+        return out;
+    }
+
+    // Clear the bits of a selection whose values do not compare true against a constant
+    // Blocks of 64 rows that are already fully deselected are skipped
+    template <compare_op Op, typename T>
+    inline void select_where(bitmap& selection, const std::vector<T>& column, const T& value) noexcept {
+        auto& words = selection.data();
+        size_t size = std::min(selection.size(), column.size());
+        for (size_t index = 0; index < words.size(); ++index) {
+            if (!words[index]) continue;
+            size_t first = index * 64;
+            size_t count = first < size ? std::min<size_t>(size - first, 64) : 0;
+            words[index] &= compare_block<Op>(column.data() + first, count, value);
+        }
+    }
+
+    template <typename T>
+    inline void select_where(bitmap& selection, const std::vector<T>& column, compare_op op, const T& value) noexcept {
+        switch (op) {
+        case compare_op::equal:
+            return select_where<compare_op::equal>(selection, column, value);
+        case compare_op::not_equal:
+            return select_where<compare_op::not_equal>(selection, column, value);
+        case compare_op::less:
+            return select_where<compare_op::less>(selection, column, value);
+        case compare_op::less_equal:
+            return select_where<compare_op::less_equal>(selection, column, value);
+        case compare_op::greater:
+            return select_where<compare_op::greater>(selection, column, value);
+        case compare_op::greater_equal:
+            return select_where<compare_op::greater_equal>(selection, column, value);
+        }
+    }
+
+    // Conjunctive filter over typed columns of a runtime view
+    // Every "where" narrows the selection with a vectorized comparison,
+    // columns are obtained with runtime_cppsv_view::get_column
+    // Bit i of the selection refers to row i + 1 of the view (row 0 is the header row)
+    template <typename CharT>
+    class column_filter {
+    public:
+        using view_type = runtime_cppsv_view<CharT>;
+    private:
+        const view_type& view;
+        bitmap selection;
+    public:
+        explicit column_filter(const view_type& view) noexcept
+            : view(view), selection(view.rows() ? view.rows() - 1 : 0, true) {}
+
+        // Keep only rows where "column[row] op value" holds
+        template <typename T>
+        column_filter& where(const std::vector<T>& column, compare_op op, const T& value) noexcept {
+            select_where(this->selection, column, op, value);
+            return *this;
+        }
+
+        // Keep only rows where "column[row] op value" holds, missing values never match
+        template <typename T>
+        column_filter& where(const nullable_column<T>& column, compare_op op, const T& value) noexcept {
+            this->selection &= column.validity;
+            select_where(this->selection, column.values, op, value);
+            return *this;
+        }
+
+        // Keep only rows that are also selected in another bitmap,
+        // rows past its size are deselected
+        column_filter& where(const bitmap& other) noexcept {
+            this->selection &= other;
+            return *this;
+        }
+
+        const bitmap& get_selection() const noexcept {
+            return this->selection;
+        }
+
+        // Get the number of selected rows
+        size_t count() const noexcept {
+            return this->selection.count();
+        }
+
+        // Get the selected rows as row indices into the view
+        row_selection<CharT> get_rows() const noexcept {
+            return row_selection<CharT>(this->view, this->selection);
+        }
+
+        // Iterate over all selected rows,
+        // calling "function(std::vector<std::basic_string_view<value_type>>)"
+        void for_each_row(auto function) const noexcept {
+            this->selection.for_each_set([&](size_t index) {
+                function(this->view.get_row(index + 1));
+            });
+        }
+    };
+
+    template <typename CharT>
+    column_filter(const runtime_cppsv_view<CharT>& view) -> column_filter<CharT>;
+}
+
+#endif /* CPPSV_INCLUDE_CPPSV_FILTER_H */
@@ -0,0 +1,184 @@
+#ifndef CPPSV_INCLUDE_CPPSV_LOOKUP_H
+#define CPPSV_INCLUDE_CPPSV_LOOKUP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <optional>
+#include <algorithm>
+#include <type_traits>
+
+#include "cppsv.h"
+#include "cppsv_table.h"
+#include "perfect_hash.h"
+
+namespace cppsv {
+    // The form of a lookup built by make_lookup
+    enum class lookup_kind {
+        dense,  // Array indexed by the key, for small contiguous integer ranges
+        hashed, // Minimal perfect hash, for strings
+        sorted  // Binary search over sorted keys
+    };
+
+    // Key to value lookup over an array indexed by the key minus the smallest key
+    template <typename Key, typename Value, size_t Range>
+    struct dense_lookup {
+        static constexpr lookup_kind kind = lookup_kind::dense;
+
+        Key first{};
+        std::array<std::optional<Value>, Range> values{};
+
+        constexpr std::optional<Value> lookup(Key key) const noexcept {
+            using unsigned_type = std::make_unsigned_t<Key>;
+            // Keys below the first wrap around to large indices
+            auto index = static_cast<unsigned_type>(static_cast<unsigned_type>(key) - static_cast<unsigned_type>(this->first));
+            if (index >= Range || !this->values[index]) return std::nullopt;
+            return this->values[index];
+        }
+    };
+
+    // String key to row index lookup over a minimal perfect hash,
+    // one hash and one comparison per lookup
+    template <typename CharT, size_t N>
+    struct key_index {
+        using view_type = std::basic_string_view<CharT>;
+        using hash_type = minimal_perfect_hash<N>;
+
+        hash_type hash{};
+        // Keys and their row indices, by slot
+        std::array<view_type, N> keys{};
+        std::array<uint32_t, N> rows{};
+
+        // Find the row index of a key (1 is the first data row), or empty if no row has it
+        constexpr std::optional<size_t> find(view_type key) const noexcept {
+            if constexpr (!N) return std::nullopt;
+            else {
+                size_t slot = this->hash(key);
+                if (this->keys[slot] != key) return std::nullopt;
+                return this->rows[slot];
+            }
+        }
+    };
+
+    // String key to value lookup over a minimal perfect hash,
+    // one hash and one comparison per lookup
+    template <typename CharT, typename Value, size_t N>
+    struct hashed_lookup {
+        using view_type = std::basic_string_view<CharT>;
+        using hash_type = minimal_perfect_hash<N>;
+        static constexpr lookup_kind kind = lookup_kind::hashed;
+
+        hash_type hash{};
+        std::array<view_type, N> keys{};
+        std::array<Value, N> values{};
+
+        constexpr std::optional<Value> lookup(view_type key) const noexcept {
+            if constexpr (!N) return std::nullopt;
+            else {
+                size_t slot = this->hash(key);
+                if (this->keys[slot] != key) return std::nullopt;
+                return this->values[slot];
+            }
+        }
+    };
+
+    // Key to value lookup with a binary search over sorted keys
+    template <typename Key, typename Value, size_t N>
+    struct sorted_lookup {
+        static constexpr lookup_kind kind = lookup_kind::sorted;
+
+        std::array<Key, N> keys{};
+        std::array<Value, N> values{};
+
+        constexpr std::optional<Value> lookup(const Key& key) const noexcept {
+            auto found = std::lower_bound(this->keys.begin(), this->keys.end(), key);
+            if (found == this->keys.end() || *found != key) return std::nullopt;
+            return this->values[found - this->keys.begin()];
+        }
+    };
+
+    // Helper for errors in lookups
+    struct lookup_errors {
+        static void duplicate_key() {}
+    };
+
+    // Build a key_index over a column of string keys of a compile time view,
+    // usable at runtime: "constexpr auto ids = cppsv::make_key_index<0>(testcsv);"
+    // Keys point into the csv, which is embedded in the binary if they are used at runtime
+    // Duplicate keys are a compile time error
+    template <size_t KeyColumn = 0, typename View>
+    consteval auto make_key_index(View) {
+        constexpr auto keys = make_table<typename View::view_type, KeyColumn>(View{});
+        constexpr size_t count = keys.size();
+        auto out = key_index<typename View::value_type, count>{};
+        auto key_array = std::array<typename View::view_type, count>{};
+        std::copy(keys.begin(), keys.end(), key_array.begin());
+        if (!out.hash.build(key_array))
+            lookup_errors::duplicate_key(); // Compile error: a key occurs more than once
+        for (size_t index = 0; index < count; ++index) {
+            size_t slot = out.hash(keys[index]);
+            out.keys[slot] = keys[index];
+            out.rows[slot] = static_cast<uint32_t>(index + 1);
+        }
+        return out;
+    }
+
+    // Build a lookup from a key column to a value column of a compile time view,
+    // in the form best suited to the keys:
+    // a dense array for integer keys covering at least half of their range,
+    // a minimal perfect hash for string keys (std::basic_string_view<value_type>),
+    // and a binary search over sorted keys otherwise
+    // Every form has "constexpr std::optional<Value> lookup(key)", usable at runtime,
+    // and "static constexpr lookup_kind kind"
+    // Strings point into the csv, which is embedded in the binary if they are used at runtime
+    // Duplicate keys and fields that cannot be converted are compile time errors
+    template <typename Key, typename Value, size_t KeyColumn = 0, size_t ValueColumn = 1, typename View>
+    consteval auto make_lookup(View) {
+        constexpr auto keys = make_table<Key, KeyColumn>(View{});
+        constexpr auto values = make_table<Value, ValueColumn>(View{});
+        constexpr size_t count = keys.size();
+        // Sort the keys, keeping the row of each
+        constexpr auto order = [&]() consteval {
+            auto out = std::array<size_t, count>{};
+            for (size_t index = 0; index < count; ++index)
+                out[index] = index;
+            std::sort(out.begin(), out.end(), [&](size_t lhs, size_t rhs) {
+                return keys[lhs] < keys[rhs] || (!(keys[rhs] < keys[lhs]) && lhs < rhs);
+            });
+            for (size_t index = 1; index < count; ++index)
+                if (!(keys[out[index - 1]] < keys[out[index]]))
+                    lookup_errors::duplicate_key(); // Compile error: a key occurs more than once
+            return out;
+        }();
+        if constexpr (std::is_same_v<Key, typename View::view_type>) {
+            auto out = hashed_lookup<typename View::value_type, Value, count>{};
+            auto key_array = std::array<Key, count>{};
+            std::copy(keys.begin(), keys.end(), key_array.begin());
+            out.hash.build(key_array);
+            for (size_t index = 0; index < count; ++index) {
+                size_t slot = out.hash(keys[index]);
+                out.keys[slot] = keys[index];
+                out.values[slot] = values[index];
+            }
+            return out;
+        }
+        else if constexpr (std::is_integral_v<Key> && !std::is_same_v<Key, bool> && count > 0
+            && static_cast<uint64_t>(keys[order[count - 1]]) - static_cast<uint64_t>(keys[order[0]]) < count * 2) {
+            constexpr size_t range = static_cast<uint64_t>(keys[order[count - 1]]) - static_cast<uint64_t>(keys[order[0]]) + 1;
+            auto out = dense_lookup<Key, Value, range>{ keys[order[0]] };
+            for (size_t index = 0; index < count; ++index)
+                out.values[static_cast<uint64_t>(keys[index]) - static_cast<uint64_t>(out.first)] = values[index];
+            return out;
+        }
+        else {
+            auto out = sorted_lookup<Key, Value, count>{};
+            for (size_t index = 0; index < count; ++index) {
+                out.keys[index] = keys[order[index]];
+                out.values[index] = values[order[index]];
+            }
+            return out;
+        }
+    }
+}
+
+#endif /* CPPSV_INCLUDE_CPPSV_LOOKUP_H */
@@ -0,0 +1,181 @@
+#ifndef CPPSV_INCLUDE_CPPSV_MPHF_H
+#define CPPSV_INCLUDE_CPPSV_MPHF_H
+
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <atomic>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "cppsv_rt.h"
+#include "bitmap.h"
+#include "parallel.h"
+#include "perfect_hash.h"
+
+namespace cppsv {
+    // Index from the fields of a key column of a runtime view to their row indices,
+    // over a minimal perfect hash function built in levels (BBHash):
+    // every level is a bitmap, keys hashing to a bit no other key of the level hashes to set it,
+    // and the colliding keys are passed on to the next level
+    // Keys are numbered by the rank of their bit, the function takes under 4 bits per key with gamma 2
+    // (including the rank table), plus 32 bits per key for the row indices
+    // Lookups hash the key once, probe about 1.5 levels on average, and compare one field
+    // The view must outlive the index
+    template <typename CharT>
+    class mphf_index {
+    public:
+        using view_type = std::basic_string_view<CharT>;
+        using value_type = CharT;
+    private:
+        static constexpr size_t max_levels = 32;
+        // Keys hashed in one task while building
+        static constexpr size_t task_keys = size_t{ 1 } << 16;
+
+        const runtime_cppsv_view<CharT>* view;
+        size_t column_index;
+        // The bitmaps of all levels, one after another
+        std::vector<uint64_t> bits;
+        // Set bits before every block of 8 words
+        std::vector<uint64_t> ranks;
+        // First bit of every level, followed by the bit count
+        std::vector<size_t> level_offsets;
+        // Row index of every key, by rank
+        std::vector<uint32_t> rows;
+        // Keys still colliding after the last level, including duplicate keys
+        std::unordered_map<view_type, uint32_t> fallback;
+
+        static constexpr size_t level_position(uint64_t hash, size_t level, size_t size) noexcept {
+            return hash_mix(hash ^ hash_mix(level + 1)) % size;
+        }
+
+        bool test(size_t index) const noexcept {
+            return this->bits[index / 64] >> (index % 64) & 1;
+        }
+
+        // Get the number of set bits before a bit
+        size_t rank(size_t index) const noexcept {
+            size_t word = index / 64;
+            size_t out = this->ranks[word / 8];
+            for (size_t block_word = word & ~size_t{ 7 }; block_word < word; ++block_word)
+                out += std::popcount(this->bits[block_word]);
+            return out + std::popcount(this->bits[word] & ((uint64_t{ 1 } << (index % 64)) - 1));
+        }
+
+        // Find the bit of a key, the first set bit it hashes to in any level
+        std::optional<size_t> find_bit(uint64_t hash) const noexcept {
+            for (size_t level = 0; level + 1 < this->level_offsets.size(); ++level) {
+                size_t first = this->level_offsets[level];
+                size_t index = first + level_position(hash, level, this->level_offsets[level + 1] - first);
+                if (this->test(index)) return index;
+            }
+            return std::nullopt;
+        }
+
+        const view_type& key(size_t row_index) const noexcept {
+            return this->view->get_row(row_index)[this->column_index];
+        }
+
+    public:
+        // Build the index over the fields of a column after the header row,
+        // on up to "threads" threads (0 uses the hardware concurrency)
+        // Levels have "gamma" bits per key passed on to them, more bits take more space
+        // but leave fewer collisions and make lookups faster
+        // If a key occurs more than once, the first row is found
+        mphf_index(const runtime_cppsv_view<CharT>& view, size_t column_index, size_t threads = 0, double gamma = 2.0)
+            : view(&view), column_index(column_index) {
+            if (view.rows() > UINT32_MAX) throw std::length_error("mphf_index: too many rows");
+            size_t key_count = view.rows() ? view.rows() - 1 : 0;
+            // Row indices and hashes of the keys left for the next level, in row order
+            auto keys = std::vector<uint32_t>(key_count);
+            auto hashes = std::vector<uint64_t>(key_count);
+            size_t tasks = (key_count + task_keys - 1) / task_keys;
+            parallel_for(tasks, threads, [&](size_t task) {
+                for (size_t index = task * task_keys; index < std::min(key_count, (task + 1) * task_keys); ++index) {
+                    keys[index] = static_cast<uint32_t>(index + 1);
+                    hashes[index] = hash_string(this->key(index + 1));
+                }
+            });
+            this->level_offsets.push_back(0);
+            for (size_t level = 0; level < max_levels && !keys.empty(); ++level) {
+                size_t size = (std::max<size_t>(static_cast<size_t>(keys.size() * gamma), 1) + 63) / 64 * 64;
+                auto hits = bitmap(size);
+                auto collisions = bitmap(size);
+                tasks = (keys.size() + task_keys - 1) / task_keys;
+                parallel_for(tasks, threads, [&](size_t task) {
+                    for (size_t index = task * task_keys; index < std::min(keys.size(), (task + 1) * task_keys); ++index) {
+                        size_t position = level_position(hashes[index], level, size);
+                        uint64_t mask = uint64_t{ 1 } << (position % 64);
+                        if (std::atomic_ref(hits.data()[position / 64]).fetch_or(mask, std::memory_order_relaxed) & mask)
+                            std::atomic_ref(collisions.data()[position / 64]).fetch_or(mask, std::memory_order_relaxed);
+                    }
+                });
+                // Keep the colliding keys in row order, so the first of duplicate keys stays first
+                auto next_keys = std::vector<std::vector<uint32_t>>(tasks);
+                auto next_hashes = std::vector<std::vector<uint64_t>>(tasks);
+                parallel_for(tasks, threads, [&](size_t task) {
+                    for (size_t index = task * task_keys; index < std::min(keys.size(), (task + 1) * task_keys); ++index) {
+                        if (collisions.test(level_position(hashes[index], level, size))) {
+                            next_keys[task].push_back(keys[index]);
+                            next_hashes[task].push_back(hashes[index]);
+                        }
+                    }
+                });
+                collisions.flip();
+                hits &= collisions;
+                this->bits.insert(this->bits.end(), hits.data().begin(), hits.data().end());
+                this->level_offsets.push_back(this->level_offsets.back() + size);
+                keys.clear();
+                hashes.clear();
+                for (size_t task = 0; task < tasks; ++task) {
+                    keys.insert(keys.end(), next_keys[task].begin(), next_keys[task].end());
+                    hashes.insert(hashes.end(), next_hashes[task].begin(), next_hashes[task].end());
+                }
+            }
+            for (auto row_index : keys)
+                this->fallback.emplace(this->key(row_index), row_index);
+            this->ranks.resize(this->bits.size() / 8 + 1);
+            for (size_t word = 0, count = 0; word < this->bits.size(); ++word) {
+                if (!(word % 8)) this->ranks[word / 8] = count;
+                count += std::popcount(this->bits[word]);
+            }
+            // Number the placed keys by the rank of their bit
+            this->rows.resize(key_count - keys.size());
+            tasks = (key_count + task_keys - 1) / task_keys;
+            parallel_for(tasks, threads, [&](size_t task) {
+                for (size_t index = task * task_keys; index < std::min(key_count, (task + 1) * task_keys); ++index) {
+                    if (auto bit = this->find_bit(hash_string(this->key(index + 1))))
+                        this->rows[this->rank(bit.value())] = static_cast<uint32_t>(index + 1);
+                }
+            });
+        }
+
+        // Get the number of distinct keys in the index
+        size_t size() const noexcept {
+            return this->rows.size() + this->fallback.size();
+        }
+
+        // Get the size of the hash function in bits, excluding the row indices
+        size_t bit_count() const noexcept {
+            return (this->bits.size() + this->ranks.size()) * 64;
+        }
+
+        // Find the row index of a key (1 is the first data row), or empty if no row has it
+        std::optional<size_t> find(view_type key) const noexcept {
+            uint64_t hash = hash_string(key);
+            if (auto bit = this->find_bit(hash)) {
+                size_t row_index = this->rows[this->rank(bit.value())];
+                if (this->key(row_index) == key) return row_index;
+            }
+            if (this->fallback.empty()) return std::nullopt;
+            auto found = this->fallback.find(key);
+            if (found == this->fallback.end()) return std::nullopt;
+            return found->second;
+        }
+    };
+}
+
+#endif /* CPPSV_INCLUDE_CPPSV_MPHF_H */
@@ -0,0 +1,155 @@
+#ifndef CPPSV_INCLUDE_CPPSV_OVERLAY_H
+#define CPPSV_INCLUDE_CPPSV_OVERLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <span>
+#include <memory>
+#include <optional>
+#include <algorithm>
+#include <unordered_map>
+
+#include "cppsv.h"
+#include "cppsv_rt.h"
+
+namespace cppsv {
+    // A compile time view (the base) with rows replaced or added by a runtime loaded csv (the delta),
+    // matched by the field in column KeyColumn
+    // The delta must have the header row of the base, and later rows of the delta
+    // replace earlier ones with the same key
+    // Lookups hash into the delta first and fall back to a sorted key index of the base
+    // built at compile time, so the base is never copied
+    // Other members may only be used if the overlay is valid()
+    template <typename View, size_t KeyColumn = 0>
+    class overlay_view {
+    public:
+        using view_type = typename View::view_type;
+        using value_type = typename View::value_type;
+        using row_type = std::span<const view_type>;
+        using delta_view_type = runtime_cppsv_view<value_type>;
+    private:
+        static_assert(KeyColumn < View::columns(), "key column out of bounds");
+
+        // Keys of the base rows after the header row with their row indices,
+        // rows with equal keys keep their order so the first one is found
+        static constexpr auto base_keys = []() consteval {
+            const auto& fields = View::embedded_fields();
+            auto out = std::array<std::pair<view_type, size_t>, View::rows() - 1>{};
+            for (size_t row_index = 1; row_index < View::rows(); ++row_index)
+                out[row_index - 1] = { fields[row_index][KeyColumn], row_index };
+            // Sorted by key and then row index
+            std::sort(out.begin(), out.end());
+            return out;
+        }();
+
+        // Kept behind a pointer, fields point into the csv buffer owned by the view
+        std::unique_ptr<delta_view_type> delta;
+        std::unordered_map<view_type, size_t> delta_keys;
+        bool consistent = false;
+
+        static constexpr const auto& base_fields() noexcept {
+            return View::embedded_fields();
+        }
+
+        static std::optional<size_t> find_base_row(view_type key) noexcept {
+            auto found = std::lower_bound(base_keys.begin(), base_keys.end(), key, [](const auto& entry, view_type key) {
+                return entry.first < key;
+            });
+            if (found == base_keys.end() || found->first != key) return std::nullopt;
+            return found->second;
+        }
+
+    public:
+        // Load the delta from a csv string, options are applied while tokenizing it (see parse_options)
+        template <typename T>
+        overlay_view(const View&, T&& delta_data, parse_options options = {})
+            : delta(std::make_unique<delta_view_type>(std::forward<T>(delta_data), options)) {
+            // The delta must have the header row of the base view
+            if (!this->delta->rows()) return;
+            const auto& header = base_fields()[0];
+            const auto& delta_header = this->delta->get_row(0);
+            this->consistent = std::equal(std::begin(header), std::end(header),
+                delta_header.begin(), delta_header.end());
+            if (!this->consistent) return;
+            this->delta_keys.reserve(this->delta->rows() - 1);
+            for (size_t row_index = 1; row_index < this->delta->rows(); ++row_index)
+                this->delta_keys.insert_or_assign(this->delta->get_row(row_index)[KeyColumn], row_index);
+        }
+
+        // Check if the delta has the header row of the base
+        bool valid() const noexcept {
+            return this->consistent;
+        }
+
+        // Get the column count in the csv
+        static constexpr size_t columns() noexcept {
+            return View::columns();
+        }
+
+        // Get the header row
+        static row_type get_header() noexcept {
+            return base_fields()[0];
+        }
+
+        // Get the delta view, row 0 is the header row
+        const delta_view_type& get_delta() const noexcept {
+            return *this->delta;
+        }
+
+        // Find the row with a key, from the delta if it has one, or from the base
+        // Returns empty if neither has the key
+        std::optional<row_type> find(view_type key) const noexcept {
+            if (auto found = this->delta_keys.find(key); found != this->delta_keys.end())
+                return row_type(this->delta->get_row(found->second));
+            if (auto row_index = find_base_row(key))
+                return row_type(base_fields()[row_index.value()]);
+            return std::nullopt;
+        }
+
+        // Check if a row with a key comes from the delta
+        bool is_overridden(view_type key) const noexcept {
+            return this->delta_keys.contains(key);
+        }
+
+        // Get a field of the row with a key by column index, or empty if no row has the key
+        std::optional<view_type> get_field(view_type key, size_t column_index) const noexcept {
+            auto row = this->find(key);
+            if (!row || column_index >= row->size()) return std::nullopt;
+            return (*row)[column_index];
+        }
+
+        // Get a field of the row with a key by column name, or empty if no row has the key
+        std::optional<view_type> get_field(view_type key, view_type column_name) const noexcept {
+            auto header = get_header();
+            size_t column_index = std::find(header.begin(), header.end(), column_name) - header.begin();
+            return this->get_field(key, column_index);
+        }
+
+        // Iterate over all rows after the header row, calling "function(std::span<const std::basic_string_view<value_type>>)"
+        // Base rows come first in order, replaced by their delta rows,
+        // followed by the delta rows with keys not in the base
+        // A delta row replaces all base rows with its key: it takes the place of the first one
+        // and the others are skipped, as find() only ever returns the first one
+        void for_each_row(auto function) const noexcept {
+            for (size_t row_index = 1; row_index < View::rows(); ++row_index) {
+                const auto& row = base_fields()[row_index];
+                auto found = this->delta_keys.find(row[KeyColumn]);
+                if (found == this->delta_keys.end()) function(row_type(row));
+                else if (find_base_row(row[KeyColumn]) == row_index)
+                    function(row_type(this->delta->get_row(found->second)));
+            }
+            for (size_t row_index = 1; row_index < this->delta->rows(); ++row_index) {
+                const auto& row = this->delta->get_row(row_index);
+                if (this->delta_keys.at(row[KeyColumn]) == row_index && !find_base_row(row[KeyColumn]))
+                    function(row_type(row));
+            }
+        }
+    };
+}
+
+#endif /* CPPSV_INCLUDE_CPPSV_OVERLAY_H */
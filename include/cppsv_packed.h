@@ -0,0 +1,326 @@
+#ifndef CPPSV_INCLUDE_CPPSV_PACKED_H
+#define CPPSV_INCLUDE_CPPSV_PACKED_H
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <utility>
+#include <vector>
+#include <string_view>
+#include <optional>
+#include <algorithm>
+
+#include "cppsv.h"
+
+namespace cppsv {
+    // Encoding of a packed column
+    enum class packed_kind : uint8_t {
+        string,        // Ids into the string pool
+        integer,       // Zigzag varints
+        sorted_integer // Non-decreasing integers, varint deltas from the first value of each block
+    };
+
+    // Number of rows per block, random access decodes at most this many varints
+    inline constexpr size_t packed_block_rows = 16;
+
+    // Packed blob layout (all u32 little endian, varints are LEB128):
+    // u32 columns, u32 data rows, u32 strings
+    // per column: u8 kind, u32 name string id, u32 offset of the column blocks
+    // u32 string offsets (strings + 1, relative to the pool), string pool
+    // per column: u32 block offsets, blocks of up to packed_block_rows varints
+    class packed_writer {
+        std::vector<char> bytes;
+    public:
+        constexpr size_t size() const noexcept {
+            return this->bytes.size();
+        }
+
+        constexpr void put_u8(uint8_t value) {
+            this->bytes.push_back(static_cast<char>(value));
+        }
+
+        constexpr void put_u32(uint32_t value) {
+            for (int index = 0; index < 4; ++index)
+                this->put_u8(static_cast<uint8_t>(value >> (index * 8)));
+        }
+
+        // Overwrite a previously written u32
+        constexpr void patch_u32(size_t offset, uint32_t value) {
+            for (int index = 0; index < 4; ++index)
+                this->bytes[offset + index] = static_cast<char>(static_cast<uint8_t>(value >> (index * 8)));
+        }
+
+        constexpr void put_varint(uint64_t value) {
+            for (; value >= 0x80; value >>= 7)
+                this->put_u8(static_cast<uint8_t>(value | 0x80));
+            this->put_u8(static_cast<uint8_t>(value));
+        }
+
+        constexpr void put_string(std::string_view str) {
+            this->bytes.insert(this->bytes.end(), str.begin(), str.end());
+        }
+
+        constexpr const std::vector<char>& data() const noexcept {
+            return this->bytes;
+        }
+    };
+
+    inline constexpr uint64_t zigzag_encode(int64_t value) noexcept {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    inline constexpr int64_t zigzag_decode(uint64_t value) noexcept {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    // Parse a field as a canonical decimal integer ("0", "-12", but not "012" or "+1"),
+    // so the original text can be reproduced from the value
+    inline constexpr std::optional<int64_t> canonical_integer(std::string_view field) noexcept {
+        bool sign = !field.empty() && field.front() == '-';
+        auto digits = field.substr(sign);
+        if (digits.empty() || digits.size() > 18 || (digits.size() > 1 && digits.front() == '0'))
+            return std::nullopt;
+        if (sign && digits == "0") return std::nullopt;
+        int64_t out = 0;
+        for (auto chr : digits) {
+            if (chr < '0' || chr > '9') return std::nullopt;
+            out = out * 10 + (chr - '0');
+        }
+        return sign ? -out : out;
+    }
+
+    // Encode a table (row 0 is the header row) into a packed blob
+    // Columns of canonical integers are stored as varints, delta encoded if sorted,
+    // other columns as ids into a pool of distinct strings
+    inline constexpr std::vector<char> pack_rows(const std::vector<std::vector<std::string_view>>& rows) {
+        size_t columns = rows.empty() ? 0 : rows[0].size();
+        size_t data_rows = rows.empty() ? 0 : rows.size() - 1;
+        auto strings = std::vector<std::string_view>();
+        auto string_id = [&](std::string_view str) {
+            size_t id = std::find(strings.begin(), strings.end(), str) - strings.begin();
+            if (id == strings.size()) strings.push_back(str);
+            return static_cast<uint32_t>(id);
+        };
+        auto kinds = std::vector<packed_kind>(columns);
+        for (size_t column = 0; column < columns; ++column) {
+            string_id(rows[0][column]);
+            bool integer = data_rows > 0;
+            bool sorted = true;
+            for (size_t row = 1; integer && row < rows.size(); ++row) {
+                auto value = canonical_integer(rows[row][column]);
+                integer = value.has_value();
+                if (integer && row > 1)
+                    sorted &= canonical_integer(rows[row - 1][column]).value() <= value.value();
+            }
+            kinds[column] = !integer ? packed_kind::string
+                : sorted && data_rows > 1 ? packed_kind::sorted_integer : packed_kind::integer;
+            if (!integer)
+                for (size_t row = 1; row < rows.size(); ++row)
+                    string_id(rows[row][column]);
+        }
+        packed_writer out;
+        out.put_u32(static_cast<uint32_t>(columns));
+        out.put_u32(static_cast<uint32_t>(data_rows));
+        out.put_u32(static_cast<uint32_t>(strings.size()));
+        auto directory = std::vector<size_t>(columns);
+        for (size_t column = 0; column < columns; ++column) {
+            out.put_u8(static_cast<uint8_t>(kinds[column]));
+            out.put_u32(string_id(rows[0][column]));
+            directory[column] = out.size();
+            out.put_u32(0);
+        }
+        uint32_t pool_offset = 0;
+        for (auto str : strings) {
+            out.put_u32(pool_offset);
+            pool_offset += static_cast<uint32_t>(str.size());
+        }
+        out.put_u32(pool_offset);
+        for (auto str : strings)
+            out.put_string(str);
+        size_t blocks = (data_rows + packed_block_rows - 1) / packed_block_rows;
+        for (size_t column = 0; column < columns; ++column) {
+            out.patch_u32(directory[column], static_cast<uint32_t>(out.size()));
+            size_t block_offsets = out.size();
+            for (size_t block = 0; block < blocks; ++block)
+                out.put_u32(0);
+            for (size_t row = 1; row < rows.size(); ++row) {
+                size_t block_row = (row - 1) % packed_block_rows;
+                if (!block_row)
+                    out.patch_u32(block_offsets + (row - 1) / packed_block_rows * 4, static_cast<uint32_t>(out.size()));
+                auto field = rows[row][column];
+                if (kinds[column] == packed_kind::string)
+                    out.put_varint(string_id(field));
+                else if (kinds[column] == packed_kind::integer || !block_row)
+                    out.put_varint(zigzag_encode(canonical_integer(field).value()));
+                else
+                    out.put_varint(static_cast<uint64_t>(canonical_integer(field).value()
+                        - canonical_integer(rows[row - 1][column]).value()));
+            }
+        }
+        return out.data();
+    }
+
+    // Encode a compile time view
+    template <typename View>
+    consteval std::vector<char> pack_view_bytes() {
+        static_assert(std::is_same_v<typename View::value_type, char>, "only char tables can be packed");
+        auto rows = std::vector<std::vector<std::string_view>>();
+        View::for_each_row([&](const auto& row) {
+            rows.emplace_back(row.begin(), row.end());
+        });
+        return pack_rows(rows);
+    }
+
+    // Upper bound of the packed size of a compile time view, found without encoding it
+    // Every field is counted as a distinct string, and the varints of a column take at most
+    // twice the characters of its fields (a delta is no longer than the two values) plus a string id each
+    template <typename View>
+    consteval size_t packed_size_bound() {
+        size_t columns = View::columns();
+        size_t fields = View::rows() * columns;
+        size_t id_bytes = 1;
+        for (size_t count = fields; count >= 0x80; count >>= 7) ++id_bytes;
+        size_t characters = 0;
+        View::for_each_field([&](const auto& field) {
+            characters += field.size();
+        });
+        size_t blocks = (View::rows() + packed_block_rows - 1) / packed_block_rows;
+        return 12 + columns * 9 + (fields + 1) * 4 + characters
+            + columns * blocks * 4 + characters * 2 + fields * (id_bytes + 1);
+    }
+
+    // Encode a compile time view into an array of packed_size_bound bytes,
+    // together with the size of the encoding
+    template <typename View>
+    consteval auto pack_view_padded() {
+        auto bytes = pack_view_bytes<View>();
+        std::pair<std::array<char, packed_size_bound<View>()>, size_t> out{};
+        std::copy(bytes.begin(), bytes.end(), out.first.begin());
+        out.second = bytes.size();
+        return out;
+    }
+
+    // Pack a compile time view into a blob, for tables that should be embedded in the binary
+    // e.g. "inline constexpr auto packed = cppsv::pack_view(testcsv);",
+    // read it with packed_table
+    template <typename View>
+    consteval auto pack_view(View) {
+        // The view is encoded once, then the padding is dropped
+        constexpr auto padded = pack_view_padded<View>();
+        std::array<char, padded.second> out{};
+        std::copy_n(padded.first.begin(), padded.second, out.begin());
+        return out;
+    }
+
+    // Random access reader over a packed blob
+    // Row 0 is the header row, only readable with get_string
+    // Usable in constant evaluated contexts
+    class packed_table {
+        const char* blob = nullptr;
+        size_t blob_size = 0;
+
+        constexpr uint8_t read_u8(size_t offset) const noexcept {
+            return static_cast<uint8_t>(this->blob[offset]);
+        }
+
+        constexpr uint32_t read_u32(size_t offset) const noexcept {
+            uint32_t out = 0;
+            for (int index = 0; index < 4; ++index)
+                out |= static_cast<uint32_t>(this->read_u8(offset + index)) << (index * 8);
+            return out;
+        }
+
+        constexpr uint64_t read_varint(size_t& offset) const noexcept {
+            uint64_t out = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t byte = this->read_u8(offset++);
+                out |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) break;
+            }
+            return out;
+        }
+
+        constexpr size_t directory(size_t column_index) const noexcept {
+            return 12 + column_index * 9;
+        }
+
+        constexpr size_t string_offsets() const noexcept {
+            return this->directory(this->columns());
+        }
+
+        constexpr std::string_view get_pool_string(size_t id) const noexcept {
+            size_t pool = this->string_offsets() + (this->read_u32(8) + size_t{ 1 }) * 4;
+            size_t first = this->read_u32(this->string_offsets() + id * 4);
+            size_t last = this->read_u32(this->string_offsets() + id * 4 + 4);
+            return std::string_view(this->blob + pool + first, last - first);
+        }
+
+        // Decode the value of a data row (row index 1 and up)
+        constexpr uint64_t get_value(size_t column_index, size_t row_index) const noexcept {
+            size_t index = row_index - 1;
+            size_t offset = this->read_u32(this->read_u32(this->directory(column_index) + 5)
+                + index / packed_block_rows * 4);
+            bool sorted = this->column_kind(column_index) == packed_kind::sorted_integer;
+            uint64_t out = this->read_varint(offset);
+            if (sorted) out = static_cast<uint64_t>(zigzag_decode(out));
+            for (size_t count = index % packed_block_rows; count; --count) {
+                uint64_t value = this->read_varint(offset);
+                out = sorted ? out + value : value;
+            }
+            return sorted ? zigzag_encode(static_cast<int64_t>(out)) : out;
+        }
+
+    public:
+        constexpr packed_table() = default;
+
+        constexpr packed_table(const char* blob, size_t size) noexcept
+            : blob(blob), blob_size(size) {}
+
+        template <size_t N>
+        constexpr packed_table(const std::array<char, N>& blob) noexcept
+            : blob(blob.data()), blob_size(N) {}
+
+        // Get the column count
+        constexpr size_t columns() const noexcept {
+            return this->blob_size >= 12 ? this->read_u32(0) : 0;
+        }
+
+        // Get the row count, including the header row
+        constexpr size_t rows() const noexcept {
+            return this->blob_size >= 12 ? this->read_u32(4) + size_t{ 1 } : 0;
+        }
+
+        constexpr packed_kind column_kind(size_t column_index) const noexcept {
+            return static_cast<packed_kind>(this->read_u8(this->directory(column_index)));
+        }
+
+        constexpr std::string_view column_name(size_t column_index) const noexcept {
+            return this->get_pool_string(this->read_u32(this->directory(column_index) + 1));
+        }
+
+        // Find a column by name
+        constexpr std::optional<size_t> column_index(std::string_view name) const noexcept {
+            for (size_t index = 0; index < this->columns(); ++index)
+                if (this->column_name(index) == name) return index;
+            return std::nullopt;
+        }
+
+        // Get a field of an integer column, or empty if the column holds strings
+        constexpr std::optional<int64_t> get_integer(size_t column_index, size_t row_index) const noexcept {
+            if (column_index >= this->columns() || !row_index || row_index >= this->rows()
+                || this->column_kind(column_index) == packed_kind::string)
+                return std::nullopt;
+            return zigzag_decode(this->get_value(column_index, row_index));
+        }
+
+        // Get a field of a string column or the header row, or empty if the column holds integers
+        constexpr std::optional<std::string_view> get_string(size_t column_index, size_t row_index) const noexcept {
+            if (column_index >= this->columns() || row_index >= this->rows()) return std::nullopt;
+            if (!row_index) return this->column_name(column_index);
+            if (this->column_kind(column_index) != packed_kind::string) return std::nullopt;
+            return this->get_pool_string(this->get_value(column_index, row_index));
+        }
+    };
+}
+
+#endif /* CPPSV_INCLUDE_CPPSV_PACKED_H */
@@ -6,103 +6,109 @@
 #include <utility>
 #include <string>
 #include <vector>
+#include <optional>
+#include <iterator>
+#include <type_traits>
 
 #include "cppsv_common.h"
 #include "convert.h"
+#include "bitmap.h"
 
 namespace cppsv {
+    template <typename CharT>
+    class row_selection;
+
+    // A typed column with missing values
+    // Missing values are value initialized in "values" and have their bit cleared in "validity",
+    // so kernels can process all values without branching and mask the results
+    template <typename T>
+    struct nullable_column {
+        std::vector<T> values;
+        bitmap validity;
+
+        size_t null_count() const noexcept {
+            return this->values.size() - this->validity.count();
+        }
+    };
+
     template <typename CharT>
     class runtime_cppsv_view {
     public:
         using view_type = std::basic_string_view<CharT>;
         using value_type = CharT;
     private:
-        // Calculate column count (defined by the first row)
-        static size_t calc_x(const auto& data) noexcept {
-            // At least 1 column
-            size_t out = 1;
-            for (bool in_quotes = false; auto chr : data) {
-                in_quotes ^= chr == '"';
-                if (!in_quotes) {
-                    if (chr == ',') ++out;
-                    if (chr == '\n') break;
-                }
-            }
-            return out;
-        }
-
-        // Calculate row count
-        static size_t calc_y(const auto& data, size_t x) noexcept {
-            size_t out = 1;
-            size_t index = 0;
-            for (bool in_quotes = false; auto chr : data) {
-                in_quotes ^= chr == '"';
-                if (!in_quotes) {
-                    if (chr == ',' && index < x)
-                        ++out, ++index;
-                    if (chr == '\n')
-                        ++out, index = 0;
-                }
-            }
-            return out / x;
-        }
-
-        // Strip wrapping quotes, comma
-        static view_type strip_field(view_type view) noexcept {
-            if (!view.empty() && (view.front() == ','))
-                view.remove_prefix(1);
-            if (view.length() > 1 && view.front() == '"' && view.back() == '"') {
-                view.remove_prefix(1);
-                view.remove_suffix(1);
-            }
-            return view;
-        }
-        
         // A 2D vector of string views of each field in the csv
         // Is not exposed - it can be iterated over, but individual entries are never returned
-        static auto calc_fields(const std::basic_string<CharT>& data) noexcept {
-            auto data_view = view_type(data);
+        static auto calc_fields(view_type data, parse_options options) noexcept {
+            auto data_view = data;
             // The header is optional at runtime, but may be present
             bool has_header = cppsv_header<CharT>::has_header(data);
             if (has_header) data_view.remove_prefix(cppsv_header<CharT>::size);
-            size_t x = calc_x(data_view);
-            size_t y = calc_y(data_view, x);
+            size_t x = count_columns(data_view, options);
+            size_t y = count_rows(data_view, x, options);
             auto out = std::vector<std::vector<view_type>>(y, std::vector<view_type>(x));
-            auto first = data_view.begin();
-            auto last = data_view.end();
-            auto field_first = first;
-            size_t index_x = 0;
-            size_t index_y = 0;
-            for (bool in_quotes = false; first != last; ++first) {
-                auto chr = *first;
-                in_quotes ^= chr == '"';
-                if (!in_quotes) {
-                    if ((chr == ',' || chr == '\n') && index_x < x) {
-                        out[index_y][index_x++] = strip_field({ field_first, first });
-                        field_first = first != last ? first + 1 : first;
-                    }
-                    if (chr == '\n') {
-                        index_x = 0;
-                        ++index_y;
-                    }
-                }
-            }
+            tokenize(data_view, x, options, [&](size_t index_x, size_t index_y, view_type field) {
+                out[index_y][index_x] = field;
+            });
             // Remove the footer
             if (has_header) out.pop_back();
             return out;
         }
 
         std::basic_string<CharT> data;
+        // A buffer not owned by the view (an embedded compile time view or a caller owned buffer),
+        // used instead of "data"
+        view_type external;
         std::vector<std::vector<view_type>> fields; 
+        parse_options options;
+
+        runtime_cppsv_view() = default;
+
+        // Convert a field, fields trimmed while tokenizing need no trimming in the converters
+        template <typename T, number_format Format>
+        std::optional<T> convert_field(view_type field) const noexcept {
+            constexpr auto untrimmed = number_format{ Format.decimal, Format.group, false };
+            if (this->options.trim != trim_policy::none)
+                return convert<T, untrimmed>(field.begin(), field.end());
+            return convert<T, Format>(field.begin(), field.end());
+        }
     public:
+        // Options are applied while tokenizing (see parse_options)
         template <typename T>
-        explicit runtime_cppsv_view(T&& data) noexcept
-            : data(std::forward<T>(data)), fields(calc_fields(this->data)) {}
+        explicit runtime_cppsv_view(T&& data, parse_options options = {}) noexcept
+            : data(std::forward<T>(data)), fields(calc_fields(this->data, options)), options(options) {}
+
+        // Create a view over the field table of a compile time view (cppsv_view) embedded in the binary
+        // The csv is not tokenized again, fields point into the embedded csv data
+        template <typename View>
+        static runtime_cppsv_view from_embedded(const View&) {
+            static_assert(std::is_same_v<typename View::value_type, CharT>, "character types differ");
+            const auto& fields = View::embedded_fields();
+            auto out = runtime_cppsv_view();
+            out.external = View::embedded_buffer();
+            out.fields.reserve(std::size(fields));
+            for (const auto& row : fields)
+                out.fields.emplace_back(std::begin(row), std::end(row));
+            out.options = View::options();
+            return out;
+        }
+
+        // Create a view over a csv buffer owned by the caller, which must outlive the view,
+        // e.g. a buffer backed by huge pages (see read_file_huge_pages)
+        // Options are applied while tokenizing (see parse_options)
+        static runtime_cppsv_view from_buffer(view_type buffer, parse_options options = {}) noexcept {
+            auto out = runtime_cppsv_view();
+            out.external = buffer;
+            out.fields = calc_fields(buffer, options);
+            out.options = options;
+            return out;
+        }
 
         // Get the column count in the csv
-        // The column count is defined by the number of fields in the first row
+        // The column count is defined by the number of fields in the first row,
+        // a view without rows has no columns
         size_t columns() const noexcept {
-            return this->fields[0].size();
+            return this->fields.empty() ? 0 : this->fields[0].size();
         }
 
         // Get the row count in the csv
@@ -110,6 +116,12 @@ namespace cppsv {
             return this->fields.size();
         }
 
+        // Get the underlying csv buffer all fields point into
+        view_type buffer() const noexcept {
+            if (!this->external.empty()) return this->external;
+            return this->data;
+        }
+
         // Get a csv row by the row index as a vector of fields
         const auto& get_row(size_t row_index) const noexcept {
             return this->fields.at(row_index);
@@ -141,6 +153,45 @@ namespace cppsv {
             return row.at(index);
         }
 
+        // Convert a column to a vector of values, one per row after the header row
+        // Numbers use the separators of Format
+        // Returns empty if any field cannot be converted
+        template <typename T, number_format Format = number_format{}>
+        std::optional<std::vector<T>> get_column(size_t column_index) const noexcept {
+            auto out = std::vector<T>();
+            // A view without rows has no header row either
+            out.reserve(this->rows() ? this->rows() - 1 : 0);
+            for (size_t row_index = 1; row_index < this->rows(); ++row_index) {
+                const auto& field = this->fields[row_index].at(column_index);
+                auto value = this->convert_field<T, Format>(field);
+                if (!value) return std::nullopt;
+                out.push_back(std::move(value.value()));
+            }
+            return out;
+        }
+
+        // Convert a column to a vector of values, one per row after the header row,
+        // with fields matching "nulls" (a combination of null_format flags) treated as missing
+        // Numbers use the separators of Format
+        // Returns empty if any other field cannot be converted
+        template <typename T, number_format Format = number_format{}>
+        std::optional<nullable_column<T>> get_nullable_column(size_t column_index,
+            unsigned int nulls = null_default) const noexcept {
+            size_t size = this->rows() ? this->rows() - 1 : 0;
+            auto out = nullable_column<T>{ std::vector<T>(size), bitmap(size, true) };
+            for (size_t row_index = 1; row_index < this->rows(); ++row_index) {
+                const auto& field = this->fields[row_index].at(column_index);
+                if (is_null(field.begin(), field.end(), nulls)) {
+                    out.validity.set(row_index - 1, false);
+                    continue;
+                }
+                auto value = this->convert_field<T, Format>(field);
+                if (!value) return std::nullopt;
+                out.values[row_index - 1] = std::move(value.value());
+            }
+            return out;
+        }
+
         // Iterate over all fields,
         // calling "function(std::basic_string_view<value_type>)"
         // Accepts only constant evaluated functions
@@ -174,6 +225,110 @@ namespace cppsv {
                 if (function(row)) return row;
             return std::vector<view_type>{ this->columns() };
         }
+
+        // Iterate over all rows
+        // while "function(std::vector<std::basic_string_view<value_type>>)" evaluates to "true"
+        // Returns the row index or empty, without copying the row
+        std::optional<size_t> find_row_index(auto function) const noexcept {
+            for (size_t row_index = 0; row_index < this->rows(); ++row_index)
+                if (function(this->fields[row_index])) return row_index;
+            return std::nullopt;
+        }
+
+        // Select all rows after the header row
+        // for which "function(std::vector<std::basic_string_view<value_type>>)" evaluates to "true"
+        // Only row indices are stored, fields are read from the view on access
+        row_selection<CharT> select_rows(auto function) const noexcept {
+            auto out = row_selection<CharT>(*this);
+            out.where(function);
+            return out;
+        }
+    };
+
+    // A selection of rows of a runtime view, stored as row indices in ascending order
+    // Rows are not copied, fields are read from the view when accessed,
+    // and narrowing the selection with "where" does not allocate
+    // The view must outlive the selection
+    template <typename CharT>
+    class row_selection {
+    public:
+        using view_type = std::basic_string_view<CharT>;
+        using value_type = CharT;
+    private:
+        const runtime_cppsv_view<CharT>* view;
+        std::vector<size_t> indices;
+    public:
+        // Select all rows after the header row
+        explicit row_selection(const runtime_cppsv_view<CharT>& view) noexcept
+            : view(&view), indices(view.rows() ? view.rows() - 1 : 0) {
+            for (size_t index = 0; index < this->indices.size(); ++index)
+                this->indices[index] = index + 1;
+        }
+
+        // Select the given row indices, which must be in ascending order
+        row_selection(const runtime_cppsv_view<CharT>& view, std::vector<size_t> indices) noexcept
+            : view(&view), indices(std::move(indices)) {}
+
+        // Select rows from a bitmap, where bit i refers to row i + 1 (row 0 is the header row)
+        row_selection(const runtime_cppsv_view<CharT>& view, const bitmap& selection) noexcept
+            : view(&view) {
+            this->indices.reserve(selection.count());
+            selection.for_each_set([&](size_t index) {
+                this->indices.push_back(index + 1);
+            });
+        }
+
+        // Get the number of selected rows
+        size_t size() const noexcept {
+            return this->indices.size();
+        }
+
+        bool empty() const noexcept {
+            return this->indices.empty();
+        }
+
+        // Get the view row index of a selected row
+        size_t row_index(size_t index) const noexcept {
+            return this->indices.at(index);
+        }
+
+        const std::vector<size_t>& row_indices() const noexcept {
+            return this->indices;
+        }
+
+        // Get a selected row as a vector of fields, without copying it
+        const auto& get_row(size_t index) const noexcept {
+            return this->view->get_row(this->row_index(index));
+        }
+
+        // Get a field of a selected row by column index or name
+        const auto& get_field(size_t index, const auto& column) const noexcept {
+            return this->view->get_field(this->get_row(index), column);
+        }
+
+        // Keep only rows
+        // for which "function(std::vector<std::basic_string_view<value_type>>)" evaluates to "true"
+        row_selection& where(auto function) noexcept {
+            std::erase_if(this->indices, [&](size_t row_index) {
+                return !function(this->view->get_row(row_index));
+            });
+            return *this;
+        }
+
+        // Keep only rows where a field predicate holds for one column
+        row_selection& where(size_t column_index, auto function) noexcept {
+            std::erase_if(this->indices, [&](size_t row_index) {
+                return !function(this->view->get_row(row_index).at(column_index));
+            });
+            return *this;
+        }
+
+        // Iterate over all selected rows,
+        // calling "function(std::vector<std::basic_string_view<value_type>>)"
+        void for_each_row(auto function) const noexcept {
+            for (auto row_index : this->indices)
+                function(this->view->get_row(row_index));
+        }
     };
 
     template <typename T>
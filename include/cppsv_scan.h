@@ -0,0 +1,224 @@
+#ifndef CPPSV_INCLUDE_CPPSV_SCAN_H
+#define CPPSV_INCLUDE_CPPSV_SCAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include "cppsv_rt.h"
+#include "parallel.h"
+
+namespace cppsv {
+    // Hint the processor to load the cache line of an address, a no-op where unsupported
+    inline void prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void)address;
+#endif
+    }
+
+    // Location of a field within the data of its row group
+    struct field_span {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    // A block of consecutive rows of a runtime view,
+    // with the spans of all of its fields stored contiguously, row by row
+    template <typename CharT>
+    class row_group {
+    public:
+        using view_type = std::basic_string_view<CharT>;
+        using value_type = CharT;
+    private:
+        const CharT* data_first;
+        size_t data_size;
+        const field_span* spans;
+        size_t first;
+        size_t count;
+        size_t column_count;
+    public:
+        row_group(const CharT* data_first, size_t data_size, const field_span* spans,
+            size_t first, size_t count, size_t column_count) noexcept
+            : data_first(data_first), data_size(data_size), spans(spans),
+            first(first), count(count), column_count(column_count) {}
+
+        // Get the view row index of the first row in the group
+        size_t first_row() const noexcept {
+            return this->first;
+        }
+
+        // Get the row count in the group
+        size_t rows() const noexcept {
+            return this->count;
+        }
+
+        size_t columns() const noexcept {
+            return this->column_count;
+        }
+
+        // Get the csv data all fields of the group point into
+        view_type data() const noexcept {
+            return view_type(this->data_first, this->data_size);
+        }
+
+        // Get a field by the column index and row index within the group
+        view_type get_field(size_t row_index, size_t column_index) const noexcept {
+            const auto& span = this->spans[row_index * this->column_count + column_index];
+            return view_type(this->data_first + span.offset, span.size);
+        }
+
+        // Issue prefetches for the field spans and the csv data of the group
+        void prefetch() const noexcept {
+            constexpr size_t line = 64;
+            const auto* spans = reinterpret_cast<const char*>(this->spans);
+            for (size_t offset = 0; offset < this->count * this->column_count * sizeof(field_span); offset += line)
+                cppsv::prefetch(spans + offset);
+            const auto* data = reinterpret_cast<const char*>(this->data_first);
+            for (size_t offset = 0; offset < this->data_size * sizeof(CharT); offset += line)
+                cppsv::prefetch(data + offset);
+        }
+    };
+
+    // Rows of a runtime view split into row groups of a fixed row count (the last one may be shorter),
+    // for scans that touch the field locations and the csv data of a group together
+    // Field locations are stored as 32-bit offsets into the data of their group,
+    // so the data of a group must be under 4GiB
+    // The view must outlive the row groups
+    template <typename CharT>
+    class row_groups {
+    public:
+        using view_type = std::basic_string_view<CharT>;
+        using value_type = CharT;
+        using group_type = row_group<CharT>;
+    private:
+        struct group_data {
+            const CharT* data_first;
+            size_t data_size;
+        };
+
+        std::vector<field_span> spans;
+        std::vector<group_data> groups;
+        size_t view_rows;
+        size_t column_count;
+        size_t group_rows;
+    public:
+        // Group the rows after the header row, "group_rows" rows per group
+        explicit row_groups(const runtime_cppsv_view<CharT>& view, size_t group_rows = 1024)
+            : spans((view.rows() ? view.rows() - 1 : 0) * view.columns()), view_rows(view.rows()),
+            column_count(view.columns()), group_rows(std::max<size_t>(group_rows, 1)) {
+            for (size_t first = 1; first < this->view_rows; first += this->group_rows) {
+                size_t last = std::min(this->view_rows, first + this->group_rows);
+                // Fields are not in buffer order if quoted or trimmed, so find the bounds of all of them
+                const CharT* data_first = nullptr;
+                const CharT* data_last = nullptr;
+                for (size_t row_index = first; row_index < last; ++row_index) {
+                    for (const auto& field : view.get_row(row_index)) {
+                        if (!field.data()) continue;
+                        if (!data_first || field.data() < data_first) data_first = field.data();
+                        if (!data_last || field.data() + field.size() > data_last) data_last = field.data() + field.size();
+                    }
+                }
+                if (static_cast<size_t>(data_last - data_first) > UINT32_MAX)
+                    throw std::length_error("row_groups: row group data too large");
+                auto* spans = this->spans.data() + (first - 1) * this->column_count;
+                for (size_t row_index = first; row_index < last; ++row_index) {
+                    const auto& row = view.get_row(row_index);
+                    for (size_t column_index = 0; column_index < this->column_count; ++column_index, ++spans) {
+                        const auto& field = row[column_index];
+                        // Fields never assigned while tokenizing have no data
+                        if (field.data())
+                            *spans = { static_cast<uint32_t>(field.data() - data_first), static_cast<uint32_t>(field.size()) };
+                    }
+                }
+                this->groups.push_back({ data_first, static_cast<size_t>(data_last - data_first) });
+            }
+        }
+
+        // Get the number of row groups
+        size_t size() const noexcept {
+            return this->groups.size();
+        }
+
+        // Get a row group by index
+        group_type operator[](size_t group_index) const noexcept {
+            size_t first = group_index * this->group_rows + 1;
+            return group_type(this->groups[group_index].data_first, this->groups[group_index].data_size,
+                this->spans.data() + (first - 1) * this->column_count,
+                first, std::min(this->group_rows, this->view_rows - first), this->column_count);
+        }
+
+        // Iterator over the row groups in order,
+        // prefetching the next group when moving to a group
+        class scan_iterator {
+            const row_groups* groups;
+            size_t index;
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = group_type;
+            using difference_type = std::ptrdiff_t;
+
+            scan_iterator() noexcept : groups(nullptr), index(0) {}
+
+            scan_iterator(const row_groups* groups, size_t index) noexcept
+                : groups(groups), index(index) {
+                this->prefetch_next();
+            }
+
+            void prefetch_next() const noexcept {
+                if (this->index + 1 < this->groups->size())
+                    (*this->groups)[this->index + 1].prefetch();
+            }
+
+            group_type operator*() const noexcept {
+                return (*this->groups)[this->index];
+            }
+
+            scan_iterator& operator++() noexcept {
+                ++this->index;
+                this->prefetch_next();
+                return *this;
+            }
+
+            void operator++(int) noexcept {
+                ++*this;
+            }
+
+            bool operator==(const scan_iterator& other) const noexcept {
+                return this->index == other.index;
+            }
+        };
+
+        scan_iterator begin() const noexcept {
+            return scan_iterator(this, 0);
+        }
+
+        scan_iterator end() const noexcept {
+            return scan_iterator(this, this->size());
+        }
+
+        // Call "function(row_group<value_type>)" for every row group
+        // on up to "threads" threads (0 uses the hardware concurrency)
+        // Each thread prefetches the next group it will process
+        // The function may be called concurrently from different threads
+        void for_each_group(auto function, size_t threads = 0) const {
+            if (!threads) threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            threads = std::max<size_t>(std::min(threads, this->size()), 1);
+            // Threads take interleaved groups, so each knows its next group in advance
+            parallel_for(threads, threads, [&](size_t thread) {
+                for (size_t index = thread; index < this->size(); index += threads) {
+                    if (index + threads < this->size())
+                        (*this)[index + threads].prefetch();
+                    function((*this)[index]);
+                }
+            });
+        }
+    };
+}
+
+#endif /* CPPSV_INCLUDE_CPPSV_SCAN_H */
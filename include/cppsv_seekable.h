@@ -0,0 +1,226 @@
+#ifndef CPPSV_INCLUDE_CPPSV_SEEKABLE_H
+#define CPPSV_INCLUDE_CPPSV_SEEKABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+
+#include "cppsv_rt.h"
+
+#ifdef CPPSV_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace cppsv {
+    // Location of a single independently compressed frame in a seekable archive
+    struct seekable_frame {
+        size_t compressed_offset;
+        size_t compressed_size;
+        size_t decompressed_offset;
+        size_t decompressed_size;
+    };
+
+    // Reader for the zstd seekable format seek table
+    // The seek table is a skippable frame at the end of the archive which stores
+    // the compressed and decompressed sizes of every frame, in order
+    struct seek_table {
+        static constexpr uint32_t skippable_magic = 0x184D2A5E;
+        static constexpr uint32_t seekable_magic = 0x8F92EAB1;
+        static constexpr size_t skippable_header_size = 8;
+        static constexpr size_t footer_size = 9;
+
+        static constexpr uint32_t read_u32(const unsigned char* bytes) noexcept {
+            return static_cast<uint32_t>(bytes[0])
+                | static_cast<uint32_t>(bytes[1]) << 8
+                | static_cast<uint32_t>(bytes[2]) << 16
+                | static_cast<uint32_t>(bytes[3]) << 24;
+        }
+
+        // Parse the seek table of a seekable archive
+        // Returns empty if the table is missing or inconsistent with the archive size
+        static std::optional<std::vector<seekable_frame>> read(const unsigned char* data, size_t size) noexcept {
+            if (size < skippable_header_size + footer_size) return std::nullopt;
+            const unsigned char* footer = data + size - footer_size;
+            if (read_u32(footer + 5) != seekable_magic) return std::nullopt;
+            unsigned char descriptor = footer[4];
+            // Reserved bits must be zero
+            if (descriptor & 0x7C) return std::nullopt;
+            size_t entry_size = descriptor & 0x80 ? 12 : 8;
+            size_t count = read_u32(footer);
+            size_t table_size = count * entry_size + footer_size;
+            if (size - skippable_header_size < table_size) return std::nullopt;
+            size_t frames_size = size - skippable_header_size - table_size;
+            const unsigned char* table = data + frames_size;
+            if (read_u32(table) != skippable_magic || read_u32(table + 4) != table_size)
+                return std::nullopt;
+            table += skippable_header_size;
+            auto out = std::vector<seekable_frame>(count);
+            size_t compressed_offset = 0;
+            size_t decompressed_offset = 0;
+            for (auto& frame : out) {
+                frame = { compressed_offset, read_u32(table), decompressed_offset, read_u32(table + 4) };
+                compressed_offset += frame.compressed_size;
+                decompressed_offset += frame.decompressed_size;
+                table += entry_size;
+            }
+            if (compressed_offset != frames_size) return std::nullopt;
+            return out;
+        }
+    };
+
+#ifdef CPPSV_WITH_ZSTD
+    // Default frame decompressor, requires linking with libzstd
+    struct zstd_decompress {
+        bool operator()(void* dst, size_t dst_size, const void* src, size_t src_size) const noexcept {
+            size_t result = ZSTD_decompress(dst, dst_size, src, src_size);
+            return !ZSTD_isError(result) && result == dst_size;
+        }
+    };
+#endif
+
+    // A runtime csv view over a seekable compressed archive
+    // Frames are decompressed and indexed on first access only, so a lookup
+    // touches just the frames containing the requested rows
+    // Frames must end on row boundaries and the first frame must start with the header row,
+    // which is prepended to every other frame so that columns can be accessed by name
+    // Decompress is called as "bool(void* dst, size_t dst_size, const void* src, size_t src_size)"
+    // Not thread safe: frames are cached on access
+    template <typename CharT, typename Decompress>
+    class seekable_cppsv_view {
+    public:
+        using view_type = std::basic_string_view<CharT>;
+        using value_type = CharT;
+        using frame_view_type = runtime_cppsv_view<CharT>;
+    private:
+        std::vector<unsigned char> archive;
+        std::vector<seekable_frame> frames;
+        Decompress decompress;
+        parse_options options;
+        // Number of data rows (excluding the header) in each frame, if known
+        size_t rows_per_frame;
+        mutable std::vector<std::unique_ptr<frame_view_type>> cache;
+        // First global data row of each frame, filled in as frames are loaded
+        mutable std::vector<size_t> first_rows;
+        mutable std::basic_string<CharT> header_row;
+
+        std::optional<std::basic_string<CharT>> decompress_frame(size_t frame_index) const noexcept {
+            const auto& frame = this->frames[frame_index];
+            auto out = std::basic_string<CharT>(frame.decompressed_size / sizeof(CharT), CharT{});
+            if (!this->decompress(out.data(), out.size() * sizeof(CharT),
+                this->archive.data() + frame.compressed_offset, frame.compressed_size))
+                return std::nullopt;
+            return out;
+        }
+
+    public:
+        // Construct from the compressed archive bytes
+        // "rows_per_frame" is the fixed number of data rows per frame if the writer used one,
+        // otherwise (0) row positions are discovered by loading frames in order
+        // Options are applied while tokenizing each frame (see parse_options)
+        template <typename T>
+        explicit seekable_cppsv_view(T&& archive, size_t rows_per_frame = 0, Decompress decompress = {},
+            parse_options options = {}) noexcept
+            : archive(std::begin(archive), std::end(archive)), decompress(std::move(decompress)),
+            options(options), rows_per_frame(rows_per_frame) {
+            auto table = seek_table::read(this->archive.data(), this->archive.size());
+            if (table) this->frames = std::move(table.value());
+            this->cache.resize(this->frames.size());
+            this->first_rows.reserve(this->frames.size());
+        }
+
+        // Check if the archive contains a valid seek table
+        bool valid() const noexcept {
+            return !this->frames.empty();
+        }
+
+        // Get the number of independently compressed frames
+        size_t frame_count() const noexcept {
+            return this->frames.size();
+        }
+
+        // Get the decompressed and indexed contents of a frame
+        // Row 0 of every frame is the header row
+        // Returns nullptr if the frame is out of bounds or cannot be decompressed
+        const frame_view_type* get_frame(size_t frame_index) const noexcept {
+            if (frame_index >= this->frame_count()) return nullptr;
+            auto& cached = this->cache[frame_index];
+            if (cached) return cached.get();
+            if (frame_index && this->header_row.empty() && !this->get_frame(0))
+                return nullptr;
+            auto data = this->decompress_frame(frame_index);
+            if (!data) return nullptr;
+            if (!frame_index) {
+                auto line_end = data->find(CharT('\n'));
+                this->header_row = data->substr(0, line_end == data->npos ? data->size() : line_end + 1);
+            }
+            else data->insert(0, this->header_row);
+            cached = std::make_unique<frame_view_type>(std::move(data.value()), this->options);
+            return cached.get();
+        }
+
+        // Find the frame containing a global row index (row 0 is the header row)
+        // Returns the frame index and the row index within that frame,
+        // or empty if the row is out of bounds
+        std::optional<std::pair<size_t, size_t>> find_frame(size_t row_index) const noexcept {
+            if (!this->valid()) return std::nullopt;
+            if (!row_index) return std::pair<size_t, size_t>{ 0, 0 };
+            if (this->rows_per_frame) {
+                size_t frame_index = (row_index - 1) / this->rows_per_frame;
+                if (frame_index >= this->frame_count()) return std::nullopt;
+                return std::pair{ frame_index, (row_index - 1) % this->rows_per_frame + 1 };
+            }
+            // Row counts are not known in advance, load frames until the row is reached
+            size_t frame_index = std::upper_bound(this->first_rows.begin(), this->first_rows.end(), row_index)
+                - this->first_rows.begin();
+            if (frame_index) --frame_index;
+            for (; frame_index < this->frame_count(); ++frame_index) {
+                const auto* frame = this->get_frame(frame_index);
+                if (!frame) return std::nullopt;
+                if (frame_index == this->first_rows.size())
+                    this->first_rows.push_back(frame_index ? this->first_rows.back()
+                        + this->get_frame(frame_index - 1)->rows() - 1 : 1);
+                size_t first_row = this->first_rows[frame_index];
+                if (row_index < first_row + frame->rows() - 1)
+                    return std::pair{ frame_index, row_index - first_row + 1 };
+            }
+            return std::nullopt;
+        }
+
+        // Get a csv row by the global row index as a vector of fields
+        // Only the frame containing the row is decompressed
+        const auto& get_row(size_t row_index) const {
+            auto location = this->find_frame(row_index);
+            const frame_view_type* frame = location ? this->get_frame(location->first) : nullptr;
+            // A frame may hold fewer rows than "rows_per_frame"
+            if (!frame || location->second >= frame->rows()) throw std::out_of_range("seekable_cppsv_view::get_row");
+            return frame->get_row(location->second);
+        }
+
+        // Get a csv field by the column name and global row index
+        const auto& get_field(const auto& column_name, size_t row_index) const {
+            const auto& row = this->get_row(row_index);
+            const frame_view_type* header = this->get_frame(0);
+            if (!header) throw std::out_of_range("seekable_cppsv_view::get_field");
+            return header->get_field(row, column_name);
+        }
+
+        // Iterate over all rows of all frames (the header row is visited once),
+        // calling "function(std::vector<std::basic_string_view<value_type>>)"
+        void for_each_row(auto function) const noexcept {
+            for (size_t frame_index = 0; frame_index < this->frame_count(); ++frame_index) {
+                const auto* frame = this->get_frame(frame_index);
+                if (!frame) return;
+                for (size_t row_index = frame_index ? 1 : 0; row_index < frame->rows(); ++row_index)
+                    function(frame->get_row(row_index));
+            }
+        }
+    };
+}
+
+#endif /* CPPSV_INCLUDE_CPPSV_SEEKABLE_H */
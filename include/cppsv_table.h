@@ -0,0 +1,119 @@
+#ifndef CPPSV_INCLUDE_CPPSV_TABLE_H
+#define CPPSV_INCLUDE_CPPSV_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <tuple>
+#include <array>
+#include <optional>
+#include <type_traits>
+
+#include "cppsv.h"
+
+namespace cppsv {
+    // A fixed size table of typed rows, one per data row of a compile time view
+    // A literal type without constructors or destructors of its own,
+    // so it is constant initialized when declared constinit (or constexpr):
+    // "constinit auto ages = cppsv::make_table<int>(testcsv, ...);"
+    // No dynamic initialization or guard variables are emitted for it
+    template <typename Row, size_t N>
+    struct table {
+        using value_type = Row;
+
+        std::array<Row, N> rows;
+
+        static constexpr size_t size() noexcept {
+            return N;
+        }
+
+        static constexpr bool empty() noexcept {
+            return !N;
+        }
+
+        constexpr const Row& operator[](size_t index) const noexcept {
+            return this->rows[index];
+        }
+
+        constexpr Row& operator[](size_t index) noexcept {
+            return this->rows[index];
+        }
+
+        constexpr auto begin() const noexcept {
+            return this->rows.begin();
+        }
+
+        constexpr auto end() const noexcept {
+            return this->rows.end();
+        }
+
+        constexpr auto begin() noexcept {
+            return this->rows.begin();
+        }
+
+        constexpr auto end() noexcept {
+            return this->rows.end();
+        }
+
+        // Find the first row
+        // for which "function(const Row&)" evaluates to "true"
+        // Returns the row index (0 is the first data row) or empty
+        constexpr std::optional<size_t> find_index(auto function) const noexcept {
+            for (size_t index = 0; index < N; ++index)
+                if (function(this->rows[index])) return index;
+            return std::nullopt;
+        }
+    };
+
+    // Helper for conversion errors in tables
+    struct table_errors {
+        static void unconvertible_field() {}
+    };
+
+    // Build a table from the rows after the header row of a compile time view,
+    // calling "function(std::array<std::basic_string_view<value_type>, columns()>)" to create each Row
+    // Accepts only constant evaluated functions
+    template <typename Row, typename View>
+    consteval auto make_table(View, auto function) {
+        auto out = table<Row, View::rows() - 1>{};
+        size_t index = 0;
+        View::for_each_row([&](const auto& row) {
+            if (index++) out.rows[index - 2] = function(row);
+        });
+        return out;
+    }
+
+    // Build a table of tuples from the rows after the header row of a compile time view,
+    // converting the first sizeof...(Ts) columns to Ts
+    // A field that cannot be converted is a compile time error
+    template <typename...Ts, typename View>
+        requires (sizeof...(Ts) > 1)
+    consteval auto make_table(View view) {
+        static_assert(sizeof...(Ts) <= View::columns(), "more types than columns");
+        return make_table<std::tuple<Ts...>>(view, [](const auto& row) {
+            return [&]<size_t...Xs>(std::index_sequence<Xs...>) {
+                return std::tuple<Ts...>{ [&]() {
+                    auto value = convert<Ts>(row[Xs].begin(), row[Xs].end());
+                    if (!value)
+                        table_errors::unconvertible_field(); // Compile error: field cannot be converted
+                    return value.value();
+                }()... };
+            }(std::index_sequence_for<Ts...>{});
+        });
+    }
+
+    // Build a table of a single column of a compile time view converted to T
+    // A field that cannot be converted is a compile time error
+    template <typename T, size_t IColumn = 0, typename View>
+    consteval auto make_table(View view) {
+        static_assert(IColumn < View::columns(), "field index out of bounds");
+        return make_table<T>(view, [](const auto& row) {
+            auto value = convert<T>(row[IColumn].begin(), row[IColumn].end());
+            if (!value)
+                table_errors::unconvertible_field(); // Compile error: field cannot be converted
+            return value.value();
+        });
+    }
+}
+
+#endif /* CPPSV_INCLUDE_CPPSV_TABLE_H */
@@ -0,0 +1,164 @@
+#ifndef CPPSV_INCLUDE_HUGE_PAGES_H
+#define CPPSV_INCLUDE_HUGE_PAGES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+#include <optional>
+#include <fstream>
+#include <filesystem>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "cppsv_rt.h"
+
+namespace cppsv {
+    // Size of the huge pages requested, 2MiB pages as on x86-64 and most AArch64 kernels
+    inline constexpr size_t huge_page_size = size_t{ 2 } << 20;
+
+    // How memory is backed by huge pages
+    enum class huge_page_policy {
+        transparent, // Transparent huge pages requested with madvise(MADV_HUGEPAGE)
+        reserved     // Pages from the reserved huge page pool (MAP_HUGETLB), transparent if none are free
+    };
+
+    // Advise the kernel to back the whole 2MiB pages within a range of memory with transparent huge pages
+    // Already allocated pages are collapsed into huge pages in the background
+    // Returns false if the advice was not taken or huge pages are unsupported
+    inline bool advise_huge_pages(const void* data, size_t size) noexcept {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        auto first = (reinterpret_cast<uintptr_t>(data) + huge_page_size - 1) & ~(huge_page_size - 1);
+        auto last = (reinterpret_cast<uintptr_t>(data) + size) & ~(huge_page_size - 1);
+        if (first >= last) return false;
+        return !madvise(reinterpret_cast<void*>(first), last - first, MADV_HUGEPAGE);
+#else
+        (void)data, (void)size;
+        return false;
+#endif
+    }
+
+    // Allocator of memory backed by huge pages, for large csv buffers
+    // Allocations are rounded up to whole huge pages and aligned to them
+    // Falls back to aligned operator new where huge pages are unsupported
+    template <typename T>
+    struct huge_page_allocator {
+        using value_type = T;
+
+        huge_page_policy policy = huge_page_policy::transparent;
+
+        constexpr huge_page_allocator() noexcept = default;
+
+        constexpr huge_page_allocator(huge_page_policy policy) noexcept
+            : policy(policy) {}
+
+        template <typename U>
+        constexpr huge_page_allocator(const huge_page_allocator<U>& other) noexcept
+            : policy(other.policy) {}
+
+        static constexpr size_t mapping_size(size_t count) noexcept {
+            return (count * sizeof(T) + huge_page_size - 1) & ~(huge_page_size - 1);
+        }
+
+        T* allocate(size_t count) {
+            size_t size = mapping_size(count);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+#ifdef MAP_HUGETLB
+            if (this->policy == huge_page_policy::reserved) {
+                void* out = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (out != MAP_FAILED) return static_cast<T*>(out);
+            }
+#endif
+            // Map an extra huge page and unmap the ends, leaving an aligned mapping
+            auto* mapping = static_cast<char*>(mmap(nullptr, size + huge_page_size,
+                PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+            if (mapping == MAP_FAILED) throw std::bad_alloc();
+            auto* out = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(mapping) + huge_page_size - 1) & ~(huge_page_size - 1));
+            if (out != mapping) munmap(mapping, out - mapping);
+            if (out + size != mapping + size + huge_page_size)
+                munmap(out + size, mapping + size + huge_page_size - (out + size));
+            madvise(out, size, MADV_HUGEPAGE);
+            return reinterpret_cast<T*>(out);
+#else
+            return static_cast<T*>(::operator new(size, std::align_val_t{ huge_page_size }));
+#endif
+        }
+
+        void deallocate(T* data, size_t count) noexcept {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            munmap(data, mapping_size(count));
+#else
+            ::operator delete(data, std::align_val_t{ huge_page_size });
+            (void)count;
+#endif
+        }
+
+        // Memory of any policy is freed the same way
+        template <typename U>
+        constexpr bool operator==(const huge_page_allocator<U>&) const noexcept {
+            return true;
+        }
+    };
+
+    template <typename CharT>
+    using huge_page_string = std::basic_string<CharT, std::char_traits<CharT>, huge_page_allocator<CharT>>;
+
+    // Read the contents of a file into a buffer backed by huge pages, or empty if it cannot be read
+    // Construct a runtime view over it with runtime_cppsv_view::from_buffer,
+    // and a huge_page_fields index over the view for random access
+    template <typename CharT>
+    inline std::optional<huge_page_string<CharT>> read_file_huge_pages(const std::filesystem::path& path,
+        huge_page_policy policy = huge_page_policy::transparent) {
+        auto file = std::ifstream(path, std::ios::binary | std::ios::ate);
+        if (!file) return std::nullopt;
+        auto size = static_cast<size_t>(file.tellg());
+        auto out = huge_page_string<CharT>(size / sizeof(CharT), CharT{}, huge_page_allocator<CharT>(policy));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(out.data()), out.size() * sizeof(CharT)))
+            return std::nullopt;
+        return out;
+    }
+
+    // The field table of a runtime view copied into one array backed by huge pages,
+    // reducing TLB misses in random access to the fields of large views
+    // Rows of a runtime view are separate allocations, this index is a single one
+    // Fields point into the csv buffer of the view, which must outlive the index
+    template <typename CharT>
+    class huge_page_fields {
+    public:
+        using view_type = std::basic_string_view<CharT>;
+        using value_type = CharT;
+    private:
+        std::vector<view_type, huge_page_allocator<view_type>> fields;
+        size_t row_count;
+        size_t column_count;
+    public:
+        explicit huge_page_fields(const runtime_cppsv_view<CharT>& view,
+            huge_page_policy policy = huge_page_policy::transparent)
+            : fields(huge_page_allocator<view_type>(policy)), row_count(view.rows()),
+            column_count(view.rows() ? view.columns() : 0) {
+            this->fields.reserve(this->row_count * this->column_count);
+            view.for_each_row([&](const auto& row) {
+                this->fields.insert(this->fields.end(), row.begin(), row.end());
+            });
+        }
+
+        size_t rows() const noexcept {
+            return this->row_count;
+        }
+
+        size_t columns() const noexcept {
+            return this->column_count;
+        }
+
+        // Get a csv field by the column and row indices
+        const view_type& get_field(size_t column_index, size_t row_index) const noexcept {
+            return this->fields.at(row_index * this->column_count + column_index);
+        }
+    };
+}
+
+#endif /* CPPSV_INCLUDE_HUGE_PAGES_H */
@@ -0,0 +1,37 @@
+#ifndef CPPSV_INCLUDE_PARALLEL_H
+#define CPPSV_INCLUDE_PARALLEL_H
+
+#include <cstddef>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace cppsv {
+    // Call "function(size_t index)" for every index in [0, count) on up to "threads" threads
+    // (0 uses the hardware concurrency), indices are handed out one at a time
+    // The calling thread takes part, so a single thread runs everything in order
+    inline void parallel_for(size_t count, size_t threads, auto function) {
+        if (!threads) threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        threads = std::min(threads, count);
+        if (threads <= 1) {
+            for (size_t index = 0; index < count; ++index)
+                function(index);
+            return;
+        }
+        std::atomic<size_t> next = 0;
+        auto worker = [&] {
+            for (size_t index; (index = next.fetch_add(1, std::memory_order_relaxed)) < count;)
+                function(index);
+        };
+        auto workers = std::vector<std::thread>();
+        workers.reserve(threads - 1);
+        for (size_t index = 1; index < threads; ++index)
+            workers.emplace_back(worker);
+        worker();
+        for (auto& thread : workers)
+            thread.join();
+    }
+}
+
+#endif /* CPPSV_INCLUDE_PARALLEL_H */
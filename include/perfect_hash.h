@@ -0,0 +1,162 @@
+#ifndef CPPSV_INCLUDE_PERFECT_HASH_H
+#define CPPSV_INCLUDE_PERFECT_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <string_view>
+#include <algorithm>
+#include <type_traits>
+
+namespace cppsv {
+    // Finalizer of a 64-bit hash (murmur3 fmix64)
+    inline constexpr uint64_t hash_mix(uint64_t h) noexcept {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCD;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // Seeded 64-bit string hash (FNV-1a with a mixed result),
+    // usable in constant evaluated contexts
+    template <typename CharT>
+    inline constexpr uint64_t hash_string(std::basic_string_view<CharT> str, uint64_t seed = 0) noexcept {
+        uint64_t h = 0xCBF29CE484222325 ^ hash_mix(seed);
+        for (auto chr : str) {
+            h ^= static_cast<std::make_unsigned_t<CharT>>(chr);
+            h *= 0x100000001B3;
+        }
+        return hash_mix(h);
+    }
+
+    // Perfect hash function over up to N distinct string keys mapping into M slots,
+    // built with hash-and-displace: keys are split into buckets and each bucket
+    // is given a pilot value that moves all of its keys into free slots
+    // Can be built and evaluated in constant evaluated contexts
+    template <size_t N, size_t M = N + N / 4 + 1>
+    struct perfect_hash {
+        static_assert(M >= N, "perfect hash needs at least as many slots as keys");
+        static constexpr size_t slot_count = M;
+        static constexpr size_t bucket_count = N / 4 + 1;
+
+        uint64_t seed{};
+        std::array<uint16_t, bucket_count> pilots{};
+
+        constexpr size_t bucket(uint64_t h) const noexcept {
+            return h % bucket_count;
+        }
+
+        static constexpr size_t position(uint64_t h, uint64_t pilot) noexcept {
+            return hash_mix(h ^ hash_mix(pilot + 1)) % M;
+        }
+
+        // Get the slot of a key, keys not in the built set map to an arbitrary slot
+        template <typename CharT>
+        constexpr size_t operator()(std::basic_string_view<CharT> key) const noexcept {
+            uint64_t h = hash_string(key, this->seed);
+            return position(h, this->pilots[this->bucket(h)]);
+        }
+
+        // Build the function over the first "count" keys
+        // Returns false if the keys contain duplicates
+        template <typename CharT>
+        constexpr bool build(const std::array<std::basic_string_view<CharT>, N>& keys, size_t count = N) noexcept {
+            // Sort a copy of the keys to find duplicates
+            auto sorted = keys;
+            std::sort(sorted.begin(), sorted.begin() + count);
+            if (std::adjacent_find(sorted.begin(), sorted.begin() + count) != sorted.begin() + count)
+                return false;
+            for (this->seed = 0; ; ++this->seed) {
+                std::array<uint64_t, N> hashes{};
+                std::array<size_t, bucket_count> sizes{};
+                size_t max_size = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    hashes[i] = hash_string(keys[i], this->seed);
+                    max_size = std::max(max_size, ++sizes[this->bucket(hashes[i])]);
+                }
+                // Group keys by bucket (counting sort)
+                std::array<size_t, bucket_count + 1> offsets{};
+                for (size_t b = 0; b < bucket_count; ++b)
+                    offsets[b + 1] = offsets[b] + sizes[b];
+                std::array<size_t, N> order{};
+                std::array<size_t, bucket_count> filled{};
+                for (size_t i = 0; i < count; ++i) {
+                    size_t b = this->bucket(hashes[i]);
+                    order[offsets[b] + filled[b]++] = i;
+                }
+                std::array<bool, M> taken{};
+                bool placed = true;
+                // Place the largest buckets first, they are the hardest to fit
+                for (size_t size = max_size; placed && size > 0; --size) {
+                    for (size_t b = 0; placed && b < bucket_count; ++b) {
+                        if (sizes[b] != size) continue;
+                        size_t first = offsets[b];
+                        size_t last = offsets[b + 1];
+                        placed = false;
+                        for (uint64_t pilot = 0; !placed && pilot <= UINT16_MAX; ++pilot) {
+                            placed = true;
+                            for (size_t i = first; placed && i < last; ++i) {
+                                size_t pos = position(hashes[order[i]], pilot);
+                                placed = !taken[pos];
+                                // Keys of one bucket must not collide with each other either
+                                for (size_t j = first; placed && j < i; ++j)
+                                    placed = pos != position(hashes[order[j]], pilot);
+                            }
+                            if (placed) {
+                                this->pilots[b] = static_cast<uint16_t>(pilot);
+                                for (size_t i = first; i < last; ++i)
+                                    taken[position(hashes[order[i]], pilot)] = true;
+                            }
+                        }
+                    }
+                }
+                if (placed) return true;
+                // No pilot fits some bucket, start over with another seed
+                this->pilots = {};
+            }
+        }
+    };
+
+    // Minimal perfect hash function over exactly N distinct string keys mapping into N slots
+    // Keys are placed by a perfect_hash into slightly more slots,
+    // and keys placed past the first N slots are remapped to the free slots among them
+    // Can be built and evaluated in constant evaluated contexts
+    template <size_t N>
+    struct minimal_perfect_hash {
+        using hash_type = perfect_hash<N>;
+        static constexpr size_t slot_count = N;
+
+        hash_type hash{};
+        std::array<uint32_t, hash_type::slot_count - N> remap{};
+
+        // Get the slot of a key, keys not in the built set map to an arbitrary slot
+        // There are no slots if N is 0
+        template <typename CharT>
+        constexpr size_t operator()(std::basic_string_view<CharT> key) const noexcept {
+            size_t slot = this->hash(key);
+            return slot < N ? slot : this->remap[slot - N];
+        }
+
+        // Build the function over the keys
+        // Returns false if the keys contain duplicates
+        template <typename CharT>
+        constexpr bool build(const std::array<std::basic_string_view<CharT>, N>& keys) noexcept {
+            if (!this->hash.build(keys)) return false;
+            std::array<bool, hash_type::slot_count> taken{};
+            for (const auto& key : keys)
+                taken[this->hash(key)] = true;
+            // As many slots past N are taken as there are free slots before N
+            size_t free = 0;
+            for (size_t slot = N; slot < hash_type::slot_count; ++slot) {
+                if (!taken[slot]) continue;
+                while (taken[free]) ++free;
+                this->remap[slot - N] = static_cast<uint32_t>(free++);
+            }
+            return true;
+        }
+    };
+}
+
+#endif /* CPPSV_INCLUDE_PERFECT_HASH_H */
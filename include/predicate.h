@@ -0,0 +1,161 @@
+#ifndef CPPSV_INCLUDE_PREDICATE_H
+#define CPPSV_INCLUDE_PREDICATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <array>
+#include <string_view>
+#include <algorithm>
+#include <type_traits>
+
+#include "cppsv_common.h"
+#include "perfect_hash.h"
+
+#ifdef CPPSV_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace cppsv {
+    // Get the first 8 bytes of a string as a zero padded word,
+    // matching a native load of the same bytes at runtime
+    template <typename CharT>
+    inline constexpr uint64_t first_word(std::basic_string_view<CharT> str) noexcept {
+        constexpr size_t char_bits = sizeof(CharT) * 8;
+        using unsigned_type = std::make_unsigned_t<CharT>;
+        uint64_t out = 0;
+        for (size_t index = 0; index < str.size() && (index + 1) * sizeof(CharT) <= 8; ++index) {
+            uint64_t chr = static_cast<unsigned_type>(str[index]);
+            if constexpr (std::endian::native == std::endian::little)
+                out |= chr << (index * char_bits);
+            else
+                out |= chr << (64 - (index + 1) * char_bits);
+        }
+        return out;
+    }
+
+    // Load up to 8 bytes into a zero padded word
+    inline uint64_t load_word(const void* ptr, size_t size) noexcept {
+        uint64_t out = 0;
+        std::memcpy(&out, ptr, size < 8 ? size : 8);
+        return out;
+    }
+
+    // Compare two byte ranges of equal size, given the precomputed first word of the second range
+    // Runtime only, reads only within the ranges
+    inline bool equal_bytes(const void* lhs, const void* rhs, size_t size, uint64_t rhs_word) noexcept {
+        auto first = static_cast<const char*>(lhs);
+        auto second = static_cast<const char*>(rhs);
+        if (load_word(first, size) != rhs_word) return false;
+        if (size <= 8) return true;
+#ifdef CPPSV_SSE2
+        if (size >= 16) {
+            auto equal16 = [&](size_t offset) {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + offset));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + offset));
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xFFFF;
+            };
+            for (size_t offset = 8; offset + 16 < size; offset += 16)
+                if (!equal16(offset)) return false;
+            // The last block may overlap already compared bytes
+            return equal16(size - 16);
+        }
+#endif
+        for (size_t offset = 8; offset + 8 < size; offset += 8)
+            if (load_word(first + offset, 8) != load_word(second + offset, 8)) return false;
+        return load_word(first + size - 8, 8) == load_word(second + size - 8, 8);
+    }
+
+    // Field predicate, "field == needle"
+    // The needle must outlive the predicate
+    template <typename CharT>
+    struct eq {
+        using view_type = std::basic_string_view<CharT>;
+
+        constexpr eq(std::basic_string_view<CharT> needle = {}) noexcept
+            : needle(needle), word(first_word(needle)) {}
+
+        constexpr bool operator()(view_type field) const noexcept {
+            if (field.size() != this->needle.size()) return false;
+            if (std::is_constant_evaluated()) return field == this->needle;
+            return equal_bytes(field.data(), this->needle.data(), field.size() * sizeof(CharT), this->word);
+        }
+
+        view_type needle;
+        uint64_t word;
+    };
+
+    template <typename CharT, size_t N> eq(const CharT(&)[N]) -> eq<CharT>;
+
+    // Field predicate, "field.starts_with(prefix)"
+    // The prefix must outlive the predicate
+    template <typename CharT>
+    struct starts_with {
+        using view_type = std::basic_string_view<CharT>;
+
+        constexpr starts_with(std::basic_string_view<CharT> prefix) noexcept
+            : prefix(prefix), word(first_word(prefix)) {}
+
+        constexpr bool operator()(view_type field) const noexcept {
+            if (field.size() < this->prefix.size()) return false;
+            if (std::is_constant_evaluated()) return field.starts_with(this->prefix);
+            return equal_bytes(field.data(), this->prefix.data(), this->prefix.size() * sizeof(CharT), this->word);
+        }
+
+        view_type prefix;
+        uint64_t word;
+    };
+
+    template <typename CharT, size_t N> starts_with(const CharT(&)[N]) -> starts_with<CharT>;
+
+    // Field predicate, "field is one of N strings"
+    // Uses a perfect hash over the strings, so a test is one hash and one comparison
+    // The strings must outlive the predicate
+    template <typename CharT, size_t N>
+    struct in_set {
+        using view_type = std::basic_string_view<CharT>;
+        using hash_type = perfect_hash<N>;
+
+        constexpr in_set(const std::array<view_type, N>& strings) noexcept {
+            // Duplicates are allowed in a set, but not in a perfect hash
+            auto keys = strings;
+            std::sort(keys.begin(), keys.end());
+            size_t count = std::unique(keys.begin(), keys.end()) - keys.begin();
+            this->hash.build(keys, count);
+            for (size_t index = 0; index < count; ++index) {
+                size_t slot = this->hash(keys[index]);
+                this->slots[slot] = eq<CharT>(keys[index]);
+                this->used[slot] = true;
+            }
+        }
+
+        template <size_t...Ns>
+        constexpr in_set(const CharT(&...strings)[Ns]) noexcept
+            : in_set(std::array<view_type, N>{ view_type(strings, Ns - 1)... }) {}
+
+        constexpr bool operator()(view_type field) const noexcept {
+            size_t slot = this->hash(field);
+            return this->used[slot] && this->slots[slot](field);
+        }
+
+        hash_type hash{};
+        std::array<eq<CharT>, hash_type::slot_count> slots{};
+        std::array<bool, hash_type::slot_count> used{};
+    };
+
+    template <typename CharT, size_t...Ns> in_set(const CharT(&...strings)[Ns]) -> in_set<CharT, sizeof...(Ns)>;
+
+    // Apply a field predicate to one column of a row,
+    // producing a row predicate for use with find_row and the like
+    // cppsv_view::find_row requires a stateless function,
+    // construct the predicate inside a lambda in that case
+    template <typename Pred>
+    inline constexpr auto on_column(size_t column_index, Pred pred) noexcept {
+        return [column_index, pred](const auto& row) {
+            return pred(row[column_index]);
+        };
+    }
+}
+
+#endif /* CPPSV_INCLUDE_PREDICATE_H */
@@ -0,0 +1,110 @@
+#include "../include/cppsv_arrow.h"
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Read bit "index" of an Arrow bitmap, least significant bit first
+static bool arrow_bit(const void* bits, size_t index) {
+    return static_cast<const uint8_t*>(bits)[index / 8] >> (index % 8) & 1;
+}
+
+// Read a string of a "vu" array, inline or from a data buffer
+static std::string_view arrow_string(const ArrowArray& array, size_t index) {
+    const auto* entry = static_cast<const unsigned char*>(array.buffers[1]) + index * 16;
+    int32_t length;
+    std::memcpy(&length, entry, 4);
+    if (length <= 12) return { reinterpret_cast<const char*>(entry + 4), static_cast<size_t>(length) };
+    int32_t buffer_index;
+    int32_t offset;
+    std::memcpy(&buffer_index, entry + 8, 4);
+    std::memcpy(&offset, entry + 12, 4);
+    const auto* data = static_cast<const char*>(array.buffers[2 + buffer_index]);
+    assert(!std::memcmp(entry + 4, data + offset, 4));
+    return { data + offset, static_cast<size_t>(length) };
+}
+
+int main() {
+    auto view = cppsv::runtime_cppsv_view<char>(std::string(
+        "name,age,score,member,balance\n"
+        "Ann,35,1.5,true,12.50\n"
+        "Bartholomew Jones,,2.25,false,-0.01\n"
+        "NULL,42,-3,true,92233720368547758.07\n"));
+
+    ArrowArray array;
+    ArrowSchema schema;
+    cppsv::export_column(view.get_column<double>(2).value(), "score", &array, &schema);
+    assert(!std::strcmp(schema.format, "g") && !std::strcmp(schema.name, "score") && !schema.flags);
+    assert(array.length == 3 && !array.null_count && !array.offset && array.n_buffers == 2 && !array.buffers[0]);
+    const auto* scores = static_cast<const double*>(array.buffers[1]);
+    assert(scores[0] == 1.5 && scores[1] == 2.25 && scores[2] == -3.0);
+    array.release(&array);
+    schema.release(&schema);
+    assert(!array.release && !schema.release);
+
+    cppsv::export_column(view.get_column<bool>(3).value(), "member", &array, &schema);
+    assert(!std::strcmp(schema.format, "b") && array.length == 3);
+    assert(arrow_bit(array.buffers[1], 0) && !arrow_bit(array.buffers[1], 1) && arrow_bit(array.buffers[1], 2));
+    array.release(&array);
+    schema.release(&schema);
+
+    // decimal<2> holds up to 19 significant digits, the precision of int64
+    cppsv::export_column(view.get_column<cppsv::decimal<2>>(4).value(), "balance", &array, &schema);
+    assert(!std::strcmp(schema.format, "d:19,2"));
+    const auto* words = static_cast<const int64_t*>(array.buffers[1]);
+    assert(words[0] == 1250 && !words[1]);
+    assert(words[2] == -1 && words[3] == -1);
+    assert(words[4] == 9223372036854775807 && !words[5]);
+    array.release(&array);
+    schema.release(&schema);
+
+    // Missing values have their validity bit cleared
+    cppsv::export_column(view.get_nullable_column<int32_t>(1).value(), "age", &array, &schema);
+    assert(!std::strcmp(schema.format, "i") && schema.flags == ARROW_FLAG_NULLABLE);
+    assert(array.length == 3 && array.null_count == 1 && array.buffers[0]);
+    assert(arrow_bit(array.buffers[0], 0) && !arrow_bit(array.buffers[0], 1) && arrow_bit(array.buffers[0], 2));
+    const auto* ages = static_cast<const int32_t*>(array.buffers[1]);
+    assert(ages[0] == 35 && ages[2] == 42);
+    array.release(&array);
+    schema.release(&schema);
+
+    // Without nulls there is no validity bitmap
+    cppsv::export_column(view.get_nullable_column<int64_t>(1, cppsv::null_literal | cppsv::null_empty).value(),
+        "age", &array, &schema);
+    assert(!std::strcmp(schema.format, "l") && array.null_count == 1);
+    array.release(&array);
+    schema.release(&schema);
+    cppsv::export_column(view.get_nullable_column<double>(2).value(), "score", &array, &schema);
+    assert(!array.null_count && !array.buffers[0] && static_cast<const double*>(array.buffers[1])[2] == -3.0);
+    array.release(&array);
+    schema.release(&schema);
+
+    // Short strings are inline, longer ones point into the csv buffer
+    cppsv::export_string_column(view, 0, "name", &array, &schema, cppsv::null_literal);
+    assert(!std::strcmp(schema.format, "vu") && schema.flags == ARROW_FLAG_NULLABLE);
+    assert(array.length == 3 && array.null_count == 1);
+    // Validity, views, one data buffer and the data buffer sizes
+    assert(array.n_buffers == 4 && array.buffers[2] == view.buffer().data());
+    assert(static_cast<const int64_t*>(array.buffers[3])[0] == static_cast<int64_t>(view.buffer().size()));
+    assert(arrow_string(array, 0) == "Ann" && arrow_string(array, 1) == "Bartholomew Jones");
+    assert(!arrow_bit(array.buffers[0], 2) && arrow_string(array, 2).empty());
+    array.release(&array);
+    schema.release(&schema);
+
+    // A record batch owns its columns and releases them with it
+    std::vector<ArrowArray> arrays(2);
+    std::vector<ArrowSchema> schemas(2);
+    cppsv::export_string_column(view, 0, "name", &arrays[0], &schemas[0]);
+    cppsv::export_column(view.get_column<double>(2).value(), "score", &arrays[1], &schemas[1]);
+    cppsv::export_record_batch(std::move(arrays), std::move(schemas), &array, &schema);
+    assert(!std::strcmp(schema.format, "+s") && schema.n_children == 2 && array.n_children == 2);
+    assert(array.length == 3 && array.n_buffers == 1 && !array.buffers[0]);
+    assert(!std::strcmp(schema.children[0]->name, "name") && !std::strcmp(schema.children[1]->format, "g"));
+    assert(!array.children[0]->null_count && arrow_string(*array.children[0], 2) == "NULL");
+    assert(static_cast<const double*>(array.children[1]->buffers[1])[1] == 2.25);
+    array.release(&array);
+    schema.release(&schema);
+    return 0;
+}
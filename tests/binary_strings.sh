@@ -0,0 +1,29 @@
+#!/bin/sh
+# Check that the compile time table of the example does not reach the binary,
+# even with every inline function emitted
+# Every field of the example csv files of at least 4 characters is searched for,
+# except the name extracted by the example ("Sofia Oliveira")
+# and fields also written in the example source (like "Brazil")
+cd "$(dirname "$0")/../example" || exit 1
+CXX=${CXX:-g++}
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+export LC_ALL=C
+# Drop the cppsv header and footer lines of each file
+for csv in *.csv; do
+    sed '1d;$d' "$csv" | tr -d '\r' | tr ',' '\n'
+done | awk 'length >= 4 && $0 != "Sofia Oliveira"' | sort -u | while read -r field; do
+    grep -q -F "$field" main.cpp || echo "$field"
+done > "$OUT/fields"
+[ -s "$OUT/fields" ] || { echo "no fields found in the example csv files"; exit 1; }
+failed=0
+for flags in "-O0 -fkeep-inline-functions" "-O2"; do
+    # shellcheck disable=SC2086
+    "$CXX" -std=c++20 $flags -c -o "$OUT/main.o" main.cpp || exit 1
+    if grep -a -o -F -f "$OUT/fields" "$OUT/main.o" > "$OUT/found"; then
+        echo "$flags: fields found in the binary:"
+        sort -u "$OUT/found"
+        failed=1
+    fi
+done
+exit $failed
@@ -0,0 +1,50 @@
+#include "../include/cppsv_filter.h"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+int main() {
+    auto all = cppsv::bitmap(100, true);
+    assert(all.size() == 100 && all.count() == 100 && all.data().size() == 2);
+    auto odd = cppsv::bitmap(100);
+    for (size_t index = 1; index < 100; index += 2)
+        odd.set(index);
+    assert(odd.count() == 50 && odd.test(99) && !odd.test(98));
+    auto even = odd;
+    even.flip();
+    assert(even.count() == 50 && even.test(0));
+
+    // Bitmaps of different sizes, the shorter one is padded with zeros
+    auto short_all = cppsv::bitmap(70, true);
+    auto narrowed = all;
+    narrowed &= short_all;
+    assert(narrowed.size() == 100 && narrowed.count() == 70 && !narrowed.test(70));
+    narrowed = short_all;
+    narrowed &= odd;
+    assert(narrowed.size() == 70 && narrowed.count() == 35);
+    auto tiny = cppsv::bitmap(3, true);
+    tiny &= cppsv::bitmap();
+    assert(!tiny.count());
+    auto merged = cppsv::bitmap(70);
+    merged |= all;
+    assert(merged.size() == 70 && merged.count() == 70 && merged.data()[1] == (uint64_t{ 1 } << 6) - 1);
+    merged = all;
+    merged |= cppsv::bitmap(10);
+    assert(merged.count() == 100);
+
+    size_t sum = 0;
+    odd.for_each_set([&](size_t index) { sum += index; });
+    assert(sum == 2500);
+
+    // Filter rows with a bitmap shorter than the view
+    auto view = cppsv::runtime_cppsv_view<char>(std::string("id,value\n1,10\n2,20\n3,30\n4,40\n"));
+    auto filter = cppsv::column_filter(view);
+    auto first_two = cppsv::bitmap(2, true);
+    filter.where(first_two);
+    assert(filter.count() == 2 && filter.get_selection().size() == 4);
+    auto values = view.get_column<int>(1).value();
+    filter.where(values, cppsv::compare_op::greater, 15);
+    assert(filter.count() == 1 && filter.get_rows().row_indices() == std::vector<size_t>{ 2 });
+    return 0;
+}
@@ -0,0 +1,20 @@
+#!/bin/sh
+# Check that the compile time errors are reported
+# Each "#ifdef CPPSV_ERROR_<name>" block of a test must fail to compile,
+# with a diagnostic naming the error function <name>
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+failed=0
+for macro in $(grep -h -o '^#ifdef CPPSV_ERROR_[A-Za-z_]*' *.cpp | cut -d' ' -f2 | sort -u); do
+    name=${macro#CPPSV_ERROR_}
+    for test in $(grep -l "^#ifdef $macro\$" *.cpp); do
+        if output=$("$CXX" -std=c++20 -fsyntax-only "-D$macro" "$test" 2>&1); then
+            echo "$test: $name is not a compile error"
+            failed=1
+        elif ! echo "$output" | grep -q "$name"; then
+            echo "$test: the error does not name $name"
+            failed=1
+        fi
+    done
+done
+exit $failed
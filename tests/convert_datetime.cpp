@@ -0,0 +1,59 @@
+#include "../include/convert.h"
+
+#include <cassert>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+using namespace std::chrono;
+
+static constexpr std::optional<sys_seconds> datetime(std::string_view text) {
+    return cppsv::to_datetime(text.begin(), text.end());
+}
+
+static constexpr std::optional<sys_days> date(std::string_view text) {
+    return cppsv::to_date(text.begin(), text.end());
+}
+
+// Runtime parsing of a contiguous buffer takes the SIMD path where available
+static std::optional<sys_seconds> runtime_datetime(const std::string& text) {
+    return cppsv::to_datetime(text.data(), text.data() + text.size());
+}
+
+int main() {
+    static_assert(date("2024-02-29") == sys_days(2024y / February / 29));
+    static_assert(!date("2023-02-29"));
+    static_assert(datetime("2024-01-02 03:04:05") == sys_days(2024y / 1 / 2) + 3h + 4min + 5s);
+    static_assert(datetime("2024-01-02T03:04:05.123+01:00") == sys_days(2024y / 1 / 2) + 2h + 4min + 5s);
+    static_assert(!datetime("2024-01-02X03:04:05"));
+
+    const char* valid[] = {
+        "2024-01-02 03:04:05", "2024-01-02T03:04:05", "2024-01-02T03:04:05Z",
+        "2024-01-02T03:04:05.123+01:00", "1999-12-31T23:59:59-05:30", "1700000000", " 2024-01-02 "
+    };
+    for (const char* text : valid) {
+        assert(runtime_datetime(text));
+        assert(runtime_datetime(text) == datetime(text));
+    }
+    assert(runtime_datetime("2024-01-02T23:59:59Z") == sys_days(2024y / 1 / 2) + 23h + 59min + 59s);
+
+    // Every digit and separator of the fixed width part is validated
+    std::string text = "2024-01-02T03:04:05";
+    for (size_t index = 0; index < text.size(); ++index) {
+        for (char replacement : { 'a', '/', ' ', ':', '-', 'T' }) {
+            std::string changed = text;
+            if (changed[index] == replacement || (index == 10 && replacement == ' ')) continue;
+            changed[index] = replacement;
+            assert(!runtime_datetime(changed));
+            assert(!datetime(changed));
+        }
+    }
+    assert(!runtime_datetime("2024-13-02 03:04:05"));
+    assert(!runtime_datetime("2024-01-32 03:04:05"));
+    assert(!runtime_datetime("2024-01-02 24:04:05"));
+    assert(!runtime_datetime("2024-01-02 03:60:05"));
+    assert(!runtime_datetime("2024-01-02 03:04:60"));
+    assert(!runtime_datetime("2024-01-02 03:04:05+01"));
+    return 0;
+}
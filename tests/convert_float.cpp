@@ -0,0 +1,75 @@
+#include "../include/convert.h"
+
+#include <cassert>
+#include <limits>
+#include <optional>
+#include <string_view>
+
+template <typename Fp, cppsv::number_format Format = cppsv::number_format{}>
+static constexpr std::optional<Fp> parse_optional(std::string_view text) {
+    return cppsv::convert<Fp, Format>(text.begin(), text.end());
+}
+
+template <typename Fp, cppsv::number_format Format = cppsv::number_format{}>
+static constexpr Fp parse(std::string_view text) {
+    auto value = parse_optional<Fp, Format>(text);
+    assert(value);
+    return value.value();
+}
+
+int main() {
+    // Significant digits past the first 19 that are all zeros still scale the result
+    assert(parse<long double>("12345678901234567890") == 12345678901234567890.0L);
+    assert(parse<long double>("1000000000000000000000") == 1e21L);
+    assert(parse<long double>("10000000000000000000.0") == 1e19L);
+    assert(parse<double>("12345678901234567890") == 12345678901234567890.0);
+    assert(parse<double>("1000000000000000000000") == 1e21);
+    assert(parse<float>("1000000000000000000000") == 1e21f);
+    static_assert(parse<double>("1000000000000000000000") == 1e21);
+
+    // Halfway between two results, ties round to even
+    assert(parse<float>("9645065.5") == 9645066.0f);
+    assert(parse<float>("96450655e-1") == 9645066.0f);
+    assert(parse<float>("9645066.5") == 9645066.0f);
+    assert(parse<double>("5699931464017745.5e0") == 5699931464017746.0);
+    assert(parse<double>("92453604521098790e-1") == 9245360452109880.0);
+    assert(parse<long double>("9223372036854775808.5") == 9223372036854775808.0L);
+    assert(parse<long double>("9223372036854775809.5") == 9223372036854775810.0L);
+    static_assert(parse<float>("9645065.5") == 9645066.0f);
+    static_assert(parse<double>("92453604521098790e-1") == 9245360452109880.0);
+    // Just above and below halfway
+    assert(parse<float>("9645065.50000000000000000000000000001") == 9645066.0f);
+    assert(parse<float>("9645066.50000000000000000000000000001") == 9645067.0f);
+    assert(parse<double>("5699931464017744.4999999999999999999999") == 5699931464017744.0);
+    // Halfway between the smallest subnormal and zero, and just above
+    assert(parse<double>("2.4703282292062327208828439643411068618e-324") == 0.0);
+    assert(parse<double>("2.4703282292062327208828439643411068619e-324") == 0x1p-1074);
+    // Halfway between the largest finite number and the next power of two, and just below
+    assert(parse<double>("1.7976931348623158079372897140530341508e308") == std::numeric_limits<double>::infinity());
+    assert(parse<double>("1.7976931348623158079372897140530341507e308") == std::numeric_limits<double>::max());
+    assert(parse<float>("3.4028235677973366163753939545814256845e38") == std::numeric_limits<float>::infinity());
+    assert(parse<float>("3.4028235677973366163753939545814256844e38") == std::numeric_limits<float>::max());
+
+    // Hexadecimal digits past the mantissa still decide the rounding
+    assert(parse<double>("0x1.00000000000008") == 1.0);
+    assert(parse<double>("0x1.000000000000080000000000000000001") == 0x1.0000000000001p0);
+    assert(parse<double>("0x1.00000000000017ffffffffffffffffff") == 0x1.0000000000001p0);
+    assert(parse<double>("0x10000000000000800000000000001p-116") == 0x1.0000000000001p-4);
+    assert(parse<float>("0x1.fffffefffffffffffffffffp127") == std::numeric_limits<float>::max());
+    assert(parse<double>("0x1.fffffffffffff8p1023") == std::numeric_limits<double>::infinity());
+    assert(parse<double>("0x1.8p-1075") == 0x1p-1074);
+    assert(parse<long double>("0x3f0.0700330f3200f6df0b") == 0x3f0.0700330f3200f6ep0L);
+    static_assert(parse<double>("0x1.000000000000080000000000000000001") == 0x1.0000000000001p0);
+
+    // The number type comes first, so it can be given explicitly
+    constexpr std::string_view integer = "-1234";
+    static_assert(cppsv::to_integer<long>(integer.begin(), integer.end()) == -1234L);
+    static_assert(cppsv::to_floating_point<double>(integer.begin(), integer.end()) == -1234.0);
+    // Hexadecimal numbers use the separators of the format too
+    constexpr auto comma = cppsv::number_format{ ',', '.' };
+    static_assert(parse<double, comma>("0x1,8p1") == 3.0);
+    static_assert(parse<double, comma>("0x1.000,8") == 4096.5);
+    static_assert(parse<double, comma>("-12.345,5") == -12345.5);
+    static_assert(parse<double, comma>("0x1.8") == 24.0);
+    return 0;
+}
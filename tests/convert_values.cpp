@@ -0,0 +1,94 @@
+#include "../include/convert.h"
+#include "../include/cppsv_rt.h"
+
+#include <cassert>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+enum class status { open, closed, pending };
+
+template <>
+struct cppsv::enum_mapping<status> {
+    static constexpr std::pair<std::string_view, status> values[]{
+        { "open", status::open }, { "closed", status::closed }, { "pending", status::pending } };
+};
+
+template <typename T>
+static constexpr std::optional<T> parse(std::string_view text) {
+    return cppsv::convert<T>(text.begin(), text.end());
+}
+
+template <int Scale>
+static constexpr std::optional<int64_t> decimal_value(std::string_view text) {
+    auto value = cppsv::to_decimal<Scale>(text.begin(), text.end());
+    if (!value) return std::nullopt;
+    return value->value;
+}
+
+static constexpr bool null_with(std::string_view text, unsigned int format) {
+    return cppsv::is_null(text.begin(), text.end(), format);
+}
+
+constexpr int64_t int64_max = std::numeric_limits<int64_t>::max();
+constexpr int64_t int64_min = std::numeric_limits<int64_t>::min();
+
+// Booleans in any case, with surrounding whitespace
+static_assert(parse<bool>("true") == true && parse<bool>(" YES ") == true && parse<bool>("1") == true);
+static_assert(parse<bool>("False") == false && parse<bool>("no") == false && parse<bool>("0") == false);
+static_assert(!parse<bool>("") && !parse<bool>("t") && !parse<bool>("yess") && !parse<bool>("2") && !parse<bool>("01"));
+
+// Enumerators by name, names are case sensitive
+static_assert(parse<status>("closed") == status::closed && parse<status>(" pending ") == status::pending);
+static_assert(!parse<status>("Closed") && !parse<status>("close") && !parse<status>("") && !parse<status>("opened"));
+
+// Decimals: zeros past the scale are accepted, other digits are not rounded
+static_assert(decimal_value<2>("1.5") == 150 && decimal_value<2>("-1.25") == -125 && decimal_value<2>("+3") == 300);
+static_assert(decimal_value<2>("1.250") == 125 && decimal_value<2>("1.") == 100 && decimal_value<2>(".5") == 50);
+static_assert(!decimal_value<2>("1.251") && !decimal_value<2>("1.255") && !decimal_value<2>("0.001"));
+static_assert(!decimal_value<2>("") && !decimal_value<2>("-") && !decimal_value<2>(".") && !decimal_value<2>("1.2.3"));
+// The int64_t range
+static_assert(decimal_value<2>("92233720368547758.07") == int64_max && !decimal_value<2>("92233720368547758.08"));
+static_assert(decimal_value<2>("-92233720368547758.08") == int64_min && !decimal_value<2>("-92233720368547758.09"));
+static_assert(decimal_value<0>("9223372036854775807") == int64_max && !decimal_value<0>("9223372036854775808"));
+static_assert(decimal_value<0>("-9223372036854775808") == int64_min && decimal_value<0>("12.000") == 12);
+static_assert(decimal_value<18>("9.223372036854775807") == int64_max && !decimal_value<18>("9.3"));
+static_assert(decimal_value<18>("-9.223372036854775808") == int64_min && !decimal_value<18>("10"));
+// Scaling up after the digits overflows too
+static_assert(decimal_value<2>("92233720368547758") == 9223372036854775800 && !decimal_value<2>("92233720368547759"));
+static_assert(cppsv::decimal<2>{ -125 }.integer_part() == -1 && cppsv::decimal<2>{ -125 }.fractional_part() == -25);
+
+// Each null_format flag recognizes its representation only
+static_assert(null_with("", cppsv::null_empty) && null_with("  ", cppsv::null_empty) && !null_with("", cppsv::null_literal));
+static_assert(null_with("NULL", cppsv::null_literal) && !null_with("NULL", cppsv::null_default & ~cppsv::null_literal));
+static_assert(null_with("NA", cppsv::null_na) && !null_with("NA", cppsv::null_default & ~cppsv::null_na));
+static_assert(null_with("\\N", cppsv::null_escape) && !null_with("\\N", cppsv::null_default & ~cppsv::null_escape));
+static_assert(!null_with("null", cppsv::null_default) && !null_with("N/A", cppsv::null_default) && !null_with("NAN", cppsv::null_default));
+static_assert(null_with(" NA ", cppsv::null_default) && !null_with("", 0));
+
+int main() {
+    auto view = cppsv::runtime_cppsv_view<char>(std::string(
+        "id,amount\n"
+        "1,1.5\n"
+        "2,NULL\n"
+        "3,\n"
+        "4,NA\n"
+        "5,\\N\n"
+        "6,2\n"));
+    // Every representation is missing by default
+    auto column = view.get_nullable_column<cppsv::decimal<2>>(1).value();
+    assert(column.values.size() == 6 && column.null_count() == 4);
+    assert(column.validity.test(0) && !column.validity.test(1) && !column.validity.test(4) && column.validity.test(5));
+    assert(column.values[0].value == 150 && column.values[5].value == 200);
+    // Only the empty field, the others cannot be converted
+    assert(!view.get_nullable_column<cppsv::decimal<2>>(1, cppsv::null_empty));
+    // Each flag on its own, with the other representations left as they are
+    auto strings = view.get_nullable_column<std::string>(1, cppsv::null_na).value();
+    assert(strings.null_count() == 1 && !strings.validity.test(3) && strings.values[1] == "NULL");
+    strings = view.get_nullable_column<std::string>(1, cppsv::null_literal | cppsv::null_escape).value();
+    assert(strings.null_count() == 2 && !strings.validity.test(1) && !strings.validity.test(4) && strings.values[2].empty());
+    auto ids = view.get_nullable_column<int>(0, 0).value();
+    assert(!ids.null_count() && ids.values[5] == 6);
+    return 0;
+}
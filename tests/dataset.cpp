@@ -0,0 +1,53 @@
+#include "../include/cppsv_dataset.h"
+
+#include <cassert>
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+
+static_assert(cppsv::match_wildcard("day-*.csv", "day-12.csv") && !cppsv::match_wildcard("day-*.csv", "other.csv"));
+static_assert(cppsv::match_wildcard("*a*b?", "xxaybz") && !cppsv::match_wildcard("a?", "a"));
+
+int main() {
+    auto directory = std::filesystem::temp_directory_path() / "cppsv_dataset_test";
+    std::filesystem::create_directories(directory);
+    std::ofstream(directory / "day-1.csv") << "id,val\n11,1\n12,2\n";
+    std::ofstream(directory / "day-2.csv") << "id,val\n21,3\n";
+    std::ofstream(directory / "other.csv") << "key,value\n1,2\n";
+    std::ofstream(directory / "empty.csv");
+
+    auto files = cppsv::glob_files(directory / "day-*.csv");
+    assert(files.size() == 2);
+    auto dataset = cppsv::dataset_view<char>(files, {}, 2);
+    assert(dataset.valid() && dataset.rows() == 4 && dataset.columns() == 2);
+    assert(dataset.get_row(0)[0] == "id" && dataset.get_row(3)[0] == "21");
+    assert(dataset.get_field("val", 2) == "2");
+    assert(dataset.find_row_index([](const auto& row) { return row[0] == "21"; }) == 3);
+    auto column = dataset.get_column<int>(1);
+    assert(column && column->size() == 3 && (*column)[2] == 3);
+
+    // A missing first file, the header rows are compared to the first loaded shard
+    auto missing_first = cppsv::dataset_view<char>({ directory / "missing.csv", files[0], files[1] });
+    assert(!missing_first.valid() && !missing_first.get_shard(0) && missing_first.rows() == 4);
+    assert(missing_first.find_shard(3) == (std::pair<size_t, size_t>{ 2, 1 }));
+    // Rows of an invalid dataset are not visited, the first shard is missing
+    assert(!missing_first.columns() && !missing_first.get_column<int>(1));
+    assert(missing_first.select_rows([](const auto&) { return true; }).empty());
+    size_t visited = 0;
+    missing_first.for_each_row([&](const auto&) { ++visited; });
+    assert(!visited && !missing_first.find_row_index([](const auto&) { return true; }));
+    bool thrown = false;
+    try { missing_first.get_field("id", 3); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+    // No file could be loaded
+    assert(!cppsv::dataset_view<char>({ directory / "missing.csv" }).valid());
+    // An empty file or another header row
+    assert(!cppsv::dataset_view<char>({ directory / "empty.csv", files[0] }).valid());
+    assert(!cppsv::dataset_view<char>({ files[0], directory / "other.csv" }).valid());
+
+    auto buffers = cppsv::dataset_view<char>::from_buffers({ "a,b\n1,x\n", "a,b\n2,y\n3,z\n" });
+    assert(buffers.valid() && buffers.rows() == 4 && buffers.get_row(3)[0] == "3");
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include "../include/cppsv_filter.h"
+#include "../include/cppsv_arrow.h"
+#include "../include/cppsv_scan.h"
+#include "../include/cppsv_mphf.h"
+
+#include <cassert>
+#include <string>
+
+// A csv file with the cppsv header and footer and nothing in between has no rows at all
+static void check_empty(const cppsv::runtime_cppsv_view<char>& view) {
+    assert(!view.rows() && !view.columns());
+    assert(view.get_column<int>(0).value().empty());
+    auto nullable = view.get_nullable_column<int>(0).value();
+    assert(nullable.values.empty() && !nullable.validity.size());
+    auto filter = cppsv::column_filter(view);
+    assert(!filter.count() && !filter.get_rows().size());
+    assert(!cppsv::row_selection<char>(view).size());
+    assert(!view.select_rows([](const auto&) { return true; }).size());
+    ArrowArray array;
+    ArrowSchema schema;
+    cppsv::export_string_column(view, 0, "name", &array, &schema);
+    assert(!array.length);
+    array.release(&array);
+    schema.release(&schema);
+    auto groups = cppsv::row_groups<char>(view);
+    assert(!groups.size() && groups.begin() == groups.end());
+    auto index = cppsv::mphf_index<char>(view, 0, 2);
+    assert(!index.size() && !index.find("key"));
+}
+
+int main() {
+    check_empty(cppsv::runtime_cppsv_view<char>(std::string("\"cppsv\"\n")));
+    check_empty(cppsv::runtime_cppsv_view<char>::from_buffer("\"cppsv\"\n"));
+    // A header row alone has no data rows
+    auto header = cppsv::runtime_cppsv_view<char>(std::string("name,age\n"));
+    assert(header.rows() == 1 && header.columns() == 2);
+    assert(header.get_column<int>(1).value().empty() && !cppsv::column_filter(header).count());
+    assert(!cppsv::mphf_index<char>(header, 0).size());
+    assert(!cppsv::row_groups<char>(header).size());
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "../include/huge_pages.h"
+
+#include <cassert>
+#include <cstdint>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+int main() {
+    // Allocations are aligned to huge pages and rounded up to whole ones
+    for (auto policy : { cppsv::huge_page_policy::transparent, cppsv::huge_page_policy::reserved }) {
+        auto allocator = cppsv::huge_page_allocator<uint64_t>(policy);
+        uint64_t* data = allocator.allocate(1000);
+        assert(!(reinterpret_cast<uintptr_t>(data) % cppsv::huge_page_size));
+        data[0] = 1;
+        data[999] = 2;
+        allocator.deallocate(data, 1000);
+        // Containers reallocate through it
+        auto values = std::vector<uint64_t, cppsv::huge_page_allocator<uint64_t>>(allocator);
+        for (uint64_t value = 0; value < 300000; ++value)
+            values.push_back(value);
+        assert(values[299999] == 299999);
+    }
+    static_assert(cppsv::huge_page_allocator<char>::mapping_size(1) == cppsv::huge_page_size);
+    static_assert(cppsv::huge_page_allocator<uint32_t>::mapping_size(cppsv::huge_page_size / 4 + 1) == 2 * cppsv::huge_page_size);
+    assert(cppsv::huge_page_allocator<char>() == cppsv::huge_page_allocator<int>(cppsv::huge_page_policy::reserved));
+
+    auto path = std::filesystem::temp_directory_path() / "cppsv_huge_pages_test.csv";
+    std::ofstream(path) << "id,name\n1,one\n2,two\n3,\"three, quoted\"\n";
+    auto buffer = cppsv::read_file_huge_pages<char>(path);
+    assert(buffer && *buffer == "id,name\n1,one\n2,two\n3,\"three, quoted\"\n");
+    assert(!cppsv::read_file_huge_pages<char>(path.parent_path() / "cppsv_missing.csv"));
+    std::filesystem::remove(path);
+
+    // The field index has the same fields as the view it was built from
+    auto view = cppsv::runtime_cppsv_view<char>::from_buffer(*buffer);
+    auto fields = cppsv::huge_page_fields<char>(view);
+    assert(fields.rows() == view.rows() && fields.columns() == view.columns());
+    for (size_t row_index = 0; row_index < view.rows(); ++row_index)
+        for (size_t column_index = 0; column_index < view.columns(); ++column_index)
+            assert(fields.get_field(column_index, row_index) == view.get_row(row_index)[column_index]);
+    assert(fields.get_field(1, 3).data() == view.get_row(3)[1].data());
+
+    auto empty = cppsv::runtime_cppsv_view<char>(std::string("\"cppsv\"\n"));
+    auto empty_fields = cppsv::huge_page_fields<char>(empty);
+    assert(!empty_fields.rows() && !empty_fields.columns());
+    return 0;
+}
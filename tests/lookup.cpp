@@ -0,0 +1,66 @@
+#include "../include/cppsv_lookup.h"
+
+#include <cassert>
+#include <string_view>
+
+CPPSV_VIEW_BEGIN
+"\"" R",,,,"cppsv-fmt(cppsv"
+id,name,sparse,offset,value
+3,Lima,10,-1000,30
+4,Rome,200,-3,40
+6,Oslo,3000,-2,60
+7,Cairo,40000,90,70
+),,,,"cppsv-fmt"
+CPPSV_VIEW_NAME(keys_csv);
+
+// Integer keys covering at least half of their range use an array
+inline constexpr auto dense = cppsv::make_lookup<int, int, 0, 4>(keys_csv);
+static_assert(dense.kind == cppsv::lookup_kind::dense);
+static_assert(dense.lookup(3) == 30 && dense.lookup(6) == 60 && dense.lookup(7) == 70);
+// A gap inside the range, and misses below and above it
+static_assert(!dense.lookup(5) && !dense.lookup(2) && !dense.lookup(8));
+static_assert(!dense.lookup(-1) && !dense.lookup(1 << 30));
+
+// String keys use a minimal perfect hash
+inline constexpr auto hashed = cppsv::make_lookup<std::string_view, int, 1, 4>(keys_csv);
+static_assert(hashed.kind == cppsv::lookup_kind::hashed);
+static_assert(hashed.lookup("Lima") == 30 && hashed.lookup("Cairo") == 70);
+static_assert(!hashed.lookup("Paris") && !hashed.lookup("") && !hashed.lookup("Lim"));
+
+// Sparse and negative integer keys use a binary search
+inline constexpr auto sparse = cppsv::make_lookup<int, int, 2, 4>(keys_csv);
+static_assert(sparse.kind == cppsv::lookup_kind::sorted);
+static_assert(sparse.lookup(10) == 30 && sparse.lookup(40000) == 70);
+static_assert(!sparse.lookup(9) && !sparse.lookup(11) && !sparse.lookup(40001));
+inline constexpr auto negative = cppsv::make_lookup<int, int, 3, 4>(keys_csv);
+static_assert(negative.kind == cppsv::lookup_kind::sorted);
+static_assert(negative.lookup(-1000) == 30 && negative.lookup(-3) == 40 && negative.lookup(90) == 70);
+static_assert(!negative.lookup(-1001) && !negative.lookup(0) && !negative.lookup(91));
+
+// A key index maps each key to its row, 1 being the first data row
+inline constexpr auto names = cppsv::make_key_index<1>(keys_csv);
+static_assert(names.find("Lima") == 1 && names.find("Oslo") == 3 && names.find("Cairo") == 4);
+static_assert(!names.find("Paris") && !names.find("lima") && !names.find("Cairo "));
+
+#ifdef CPPSV_ERROR_duplicate_key
+CPPSV_VIEW_BEGIN
+"\"" R",,"cppsv-fmt(cppsv"
+id,name
+1,Lima
+2,Lima
+1,Rome
+),,"cppsv-fmt"
+CPPSV_VIEW_NAME(duplicate_csv);
+
+// Both are compile errors, the first on the string keys, the second on the integer keys
+inline constexpr auto duplicate_names = cppsv::make_key_index<1>(duplicate_csv);
+inline constexpr auto duplicate_ids = cppsv::make_lookup<int, std::string_view>(duplicate_csv);
+#endif
+
+int main() {
+    // Lookups work at runtime too
+    volatile int key = 4;
+    assert(dense.lookup(key) == 40 && sparse.lookup(key * 50) == 40);
+    assert(names.find(std::string_view("Rome")) == 2);
+    return 0;
+}
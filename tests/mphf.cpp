@@ -0,0 +1,44 @@
+#include "../include/cppsv_mphf.h"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+int main() {
+    // More keys than are hashed in one task, so that levels are built by several tasks
+    constexpr size_t key_count = 70000;
+    std::string csv = "key,value\n";
+    for (size_t index = 0; index < key_count; ++index)
+        csv += "key-" + std::to_string(index * 7919) + "," + std::to_string(index) + "\n";
+    auto view = cppsv::runtime_cppsv_view<char>(csv);
+    assert(view.rows() == key_count + 1);
+
+    for (size_t threads : { 1, 4 }) {
+        auto index = cppsv::mphf_index<char>(view, 0, threads);
+        // Every key finds its own row, so every key has a slot of its own
+        assert(index.size() == key_count);
+        for (size_t row_index = 1; row_index < view.rows(); ++row_index)
+            assert(index.find(view.get_row(row_index)[0]) == row_index);
+        // The hash function stays under 4 bits per key
+        assert(index.bit_count() < 4 * key_count);
+        for (size_t missing = 0; missing < 1000; ++missing)
+            assert(!index.find("absent-" + std::to_string(missing)));
+        assert(!index.find(""));
+    }
+
+    // Duplicate keys find the first row with the key
+    auto duplicates = cppsv::runtime_cppsv_view<char>(std::string("key,value\na,1\nb,2\na,3\nc,4\nb,5\n"));
+    auto index = cppsv::mphf_index<char>(duplicates, 0);
+    assert(index.size() == 3);
+    assert(index.find("a") == 1);
+    assert(index.find("b") == 2);
+    assert(index.find("c") == 4);
+    assert(!index.find("d"));
+
+    // A view with only a header row has no keys
+    auto header_only = cppsv::runtime_cppsv_view<char>(std::string("key,value\n"));
+    auto empty = cppsv::mphf_index<char>(header_only, 0);
+    assert(empty.size() == 0);
+    assert(!empty.find("key"));
+    return 0;
+}
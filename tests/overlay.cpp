@@ -0,0 +1,64 @@
+#include "../include/cppsv_overlay.h"
+
+#include <cassert>
+#include <string>
+#include <vector>
+#include <string_view>
+
+// Oslo appears twice in the base
+CPPSV_VIEW_BEGIN
+"\"" R",,"cppsv-fmt(cppsv"
+city,country,population
+Lima,Peru,10
+Oslo,Norway,1
+Rome,Italy,3
+Oslo,Norway,2
+Cairo,Egypt,20
+),,"cppsv-fmt"
+CPPSV_VIEW_NAME(cities_csv);
+
+using overlay = cppsv::overlay_view<decltype(cities_csv)>;
+
+// Collect the rows visited by for_each_row as "key:population"
+static std::vector<std::string> visited(const overlay& view) {
+    auto out = std::vector<std::string>();
+    view.for_each_row([&](const auto& row) {
+        out.push_back(std::string(row[0]) + ":" + std::string(row[2]));
+    });
+    return out;
+}
+
+int main() {
+    // Without a delta the first of the duplicate base rows is found
+    auto base_only = overlay(cities_csv, std::string("city,country,population\n"));
+    assert(base_only.valid() && base_only.get_field("Oslo", 2) == "1");
+    assert(!base_only.find("Paris") && !base_only.is_overridden("Lima"));
+    assert((visited(base_only) == std::vector<std::string>{ "Lima:10", "Oslo:1", "Rome:3", "Oslo:2", "Cairo:20" }));
+
+    auto view = overlay(cities_csv, std::string(
+        "city,country,population\n"
+        "Rome,Italy,4\n"
+        "Paris,France,11\n"
+        "Rome,Italy,5\n"
+        "Oslo,Norway,7\n"));
+    assert(view.valid() && view.get_delta().rows() == 5);
+    // A delta row overrides a base row, and a later delta row replaces an earlier one
+    assert(view.get_field("Rome", "population") == "5" && view.is_overridden("Rome"));
+    // Rows only in the base or only in the delta
+    assert(view.get_field("Lima", 2) == "10" && !view.is_overridden("Lima"));
+    assert(view.get_field("Paris", "country") == "France" && view.is_overridden("Paris"));
+    // Missing keys, columns and column names
+    assert(!view.find("Berlin") && !view.get_field("Lima", 3) && !view.get_field("Lima", "area"));
+    // The overridden duplicate base rows give one row in place of the first,
+    // then come the keys only in the delta
+    assert((visited(view) == std::vector<std::string>{ "Lima:10", "Oslo:7", "Rome:5", "Cairo:20", "Paris:11" }));
+
+    // The delta must have the header row of the base
+    auto reordered = overlay(cities_csv, std::string("country,city,population\nItaly,Rome,4\n"));
+    assert(!reordered.valid());
+    auto missing_column = overlay(cities_csv, std::string("city,country\nRome,Italy\n"));
+    assert(!missing_column.valid());
+    auto empty = overlay(cities_csv, std::string("\"cppsv\"\n"));
+    assert(!empty.valid());
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "../include/cppsv_packed.h"
+
+#include <cassert>
+#include <cstdint>
+#include <string_view>
+
+// 37 data rows, three blocks of up to 16 rows
+CPPSV_VIEW_BEGIN
+"\"" R",,,"cppsv-fmt(cppsv"
+id,score,city,code
+-19,-1,Lima,012
+-18,15648,Rome,+1
+-15,141606,Oslo,-0
+-8,231882,Cairo,7
+-8,104610,Lima,012
+-8,0,Rome,+1
+-1,260047,Oslo,-0
+2,127374,Cairo,7
+3,-56326,Lima,012
+4,53123,Rome,+1
+11,-269948,Oslo,-0
+18,-6729,Cairo,7
+25,-128978,Lima,012
+26,42245,Rome,+1
+27,268082,Oslo,-0
+28,299738,Cairo,7
+35,296752,Lima,012
+35,-190869,Rome,+1
+35,-78620,Oslo,-0
+36,-19942,Cairo,7
+36,-999999999999999999,Lima,012
+39,-169521,Rome,+1
+39,-233457,Oslo,-0
+42,205415,Cairo,7
+49,206995,Lima,012
+56,-207183,Rome,+1
+63,60794,Oslo,-0
+70,-230153,Cairo,7
+77,130400,Lima,012
+78,-141912,Rome,+1
+81,-278898,Oslo,-0
+81,8167,Cairo,7
+81,147890,Lima,012
+82,135365,Rome,+1
+89,-175307,Oslo,-0
+90,-253664,Cairo,7
+93,-252877,Lima,012
+),,,"cppsv-fmt"
+CPPSV_VIEW_NAME(table_csv);
+
+inline constexpr auto packed = cppsv::pack_view(table_csv);
+inline constexpr cppsv::packed_table table(packed);
+
+inline constexpr int64_t ids[]{ -19, -18, -15, -8, -8, -8, -1, 2, 3, 4, 11, 18, 25, 26, 27, 28, 35, 35, 35, 36, 36, 39, 39, 42, 49, 56, 63, 70, 77, 78, 81, 81, 81, 82, 89, 90, 93 };
+inline constexpr int64_t scores[]{ -1, 15648, 141606, 231882, 104610, 0, 260047, 127374, -56326, 53123, -269948, -6729, -128978, 42245, 268082, 299738, 296752, -190869, -78620, -19942, -999999999999999999, -169521, -233457, 205415, 206995, -207183, 60794, -230153, 130400, -141912, -278898, 8167, 147890, 135365, -175307, -253664, -252877 };
+inline constexpr std::string_view cities[]{ "Lima", "Rome", "Oslo", "Cairo" };
+inline constexpr std::string_view codes[]{ "012", "+1", "-0", "7" };
+
+static_assert(table.columns() == 4 && table.rows() == 38);
+// Sorted integers are delta encoded, unsorted and negative ones are zigzag varints
+static_assert(table.column_kind(0) == cppsv::packed_kind::sorted_integer);
+static_assert(table.column_kind(1) == cppsv::packed_kind::integer);
+static_assert(table.column_kind(2) == cppsv::packed_kind::string);
+// Non-canonical integers ("012", "+1", "-0") are kept as strings to reproduce the text
+static_assert(table.column_kind(3) == cppsv::packed_kind::string);
+static_assert(table.column_index("city") == 2 && !table.column_index("missing"));
+
+// Every distinct string is stored once: 4 column names, 4 cities and 4 codes
+static_assert(static_cast<uint8_t>(packed[8]) == 12 && !packed[9] && !packed[10] && !packed[11]);
+
+// The header row is read as strings, also for integer columns
+static_assert(table.get_string(0, 0) == "id" && table.get_string(1, 0) == "score");
+static_assert(!table.get_integer(0, 0));
+
+// Out of range rows and columns, and fields of the other kind
+static_assert(!table.get_integer(0, 38) && !table.get_string(2, 38));
+static_assert(!table.get_integer(4, 1) && !table.get_string(4, 0));
+static_assert(!table.get_integer(2, 1) && !table.get_string(0, 1));
+
+int main() {
+    for (size_t row_index = 1; row_index < table.rows(); ++row_index) {
+        assert(table.get_integer(0, row_index) == ids[row_index - 1]);
+        assert(table.get_integer(1, row_index) == scores[row_index - 1]);
+        assert(table.get_string(2, row_index) == cities[(row_index - 1) % 4]);
+        assert(table.get_string(3, row_index) == codes[(row_index - 1) % 4]);
+    }
+    // Blobs can also be read from a pointer and a size
+    auto runtime_table = cppsv::packed_table(packed.data(), packed.size());
+    assert(runtime_table.get_integer(1, 37) == scores[36] && runtime_table.column_name(3) == "code");
+    assert(!cppsv::packed_table().columns() && !cppsv::packed_table().rows());
+    return 0;
+}
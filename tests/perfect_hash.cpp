@@ -0,0 +1,53 @@
+#include "../include/perfect_hash.h"
+
+#include <cassert>
+#include <array>
+#include <string>
+#include <vector>
+#include <string_view>
+
+// Check that every key maps to a different slot below the slot count
+template <typename Hash, size_t N>
+static constexpr bool distinct_slots(const Hash& hash, const std::array<std::string_view, N>& keys) {
+    std::array<bool, Hash::slot_count> taken{};
+    for (auto key : keys) {
+        size_t slot = hash(key);
+        if (slot >= Hash::slot_count || taken[slot]) return false;
+        taken[slot] = true;
+    }
+    return true;
+}
+
+static constexpr std::array<std::string_view, 8> countries{
+    "Brazil", "Peru", "China", "Italy", "Mexico", "Russia", "Egypt", "France"
+};
+
+static_assert([] {
+    auto hash = cppsv::perfect_hash<8>{};
+    return hash.build(countries) && distinct_slots(hash, countries);
+}());
+static_assert([] {
+    auto hash = cppsv::minimal_perfect_hash<8>{};
+    return hash.build(countries) && distinct_slots(hash, countries);
+}());
+static_assert([] {
+    auto keys = countries;
+    keys[7] = "Peru";
+    return !cppsv::perfect_hash<8>{}.build(keys);
+}());
+
+int main() {
+    // Many keys, with buckets of different sizes
+    static std::vector<std::string> names;
+    auto keys = std::array<std::string_view, 2000>{};
+    for (size_t index = 0; index < keys.size(); ++index)
+        names.push_back("key" + std::to_string(index * 7919));
+    for (size_t index = 0; index < keys.size(); ++index)
+        keys[index] = names[index];
+    auto hash = cppsv::minimal_perfect_hash<2000>{};
+    assert(hash.build(keys) && distinct_slots(hash, keys));
+    // Only the first "count" keys
+    auto partial = cppsv::perfect_hash<2000>{};
+    assert(partial.build(keys, 10));
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "../include/predicate.h"
+
+#include <cassert>
+#include <array>
+#include <string>
+#include <string_view>
+
+// Compile time comparisons
+static_assert(cppsv::eq("Brazil")("Brazil") && !cppsv::eq("Brazil")("Brazi") && !cppsv::eq("Brazil")("Brazil!"));
+static_assert(cppsv::starts_with("Bra")("Brazil") && !cppsv::starts_with("Bra")("Br") && !cppsv::starts_with("Bra")("bra"));
+static_assert(cppsv::in_set{ "Brazil", "Peru", "Peru" }("Peru") && !cppsv::in_set{ "Brazil", "Peru" }("Chile"));
+
+// Check eq and starts_with on strings of a size, and on strings differing from them in one byte,
+// at runtime: up to 8 bytes compare a single word, up to 16 bytes the word and a scalar tail,
+// and longer strings blocks of 16 bytes (with SSE2) or words
+static void check_size(size_t size) {
+    auto needle = std::string();
+    for (size_t index = 0; index < size; ++index)
+        needle += static_cast<char>('a' + index % 26);
+    // Copies, so the comparisons read the bytes
+    auto field = std::string(needle);
+    auto pred = cppsv::eq<char>(needle);
+    assert(pred(field) && cppsv::starts_with<char>(needle)(field));
+    for (size_t index = 0; index < size; ++index) {
+        auto other = field;
+        other[index] = '#';
+        assert(!pred(other) && !cppsv::starts_with<char>(needle)(other));
+    }
+    // Shorter and longer fields
+    if (size) assert(!pred(std::string_view(field).substr(0, size - 1)));
+    auto longer = field + "xyz" + field;
+    assert(!pred(longer) && cppsv::starts_with<char>(needle)(longer));
+    assert(!cppsv::starts_with<char>(longer)(field));
+    auto changed = longer;
+    if (size) changed[size - 1] = '#';
+    assert(!size || !cppsv::starts_with<char>(needle)(changed));
+}
+
+int main() {
+    for (size_t size : { 0, 1, 7, 8, 9, 12, 15, 16, 17, 24, 31, 32, 33, 48, 100 })
+        check_size(size);
+
+    auto set = cppsv::in_set{ "Brazil", "Peru", "Argentina and Chile", "United States of America" };
+    assert(set(std::string("Argentina and Chile")) && set(std::string("United States of America")));
+    assert(!set(std::string("United States of Americo")) && !set(std::string("Argentina and Chile ")));
+    assert(!set(std::string("")) && !set(std::string("Per")));
+    auto row = std::array<std::string_view, 2>{ "1", "Peru" };
+    assert(cppsv::on_column(1, set)(row) && !cppsv::on_column(0, set)(row));
+    return 0;
+}
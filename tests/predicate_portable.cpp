@@ -0,0 +1,3 @@
+// The predicate tests without the SSE2 fast paths
+#define CPPSV_NO_SIMD
+#include "predicate.cpp"
@@ -0,0 +1,28 @@
+#!/bin/sh
+# Build and run every test, with the sanitizers where the compiler supports them
+# Usage: tests/run.sh [compiler], the compiler defaults to $CXX or g++
+cd "$(dirname "$0")" || exit 1
+CXX=${1:-${CXX:-g++}}
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+failed=0
+for test in *.cpp; do
+    name=${test%.cpp}
+    if ! "$CXX" -std=c++20 -O1 -g -fsanitize=address,undefined -pthread \
+        -o "$OUT/$name" "$test" || ! "$OUT/$name"; then
+        echo "FAILED: $name"
+        failed=1
+    else
+        echo "passed: $name"
+    fi
+done
+for script in *.sh; do
+    [ "$script" = run.sh ] && continue
+    if ! CXX="$CXX" sh "$script"; then
+        echo "FAILED: ${script%.sh}"
+        failed=1
+    else
+        echo "passed: ${script%.sh}"
+    fi
+done
+exit $failed
@@ -0,0 +1,73 @@
+#include "../include/cppsv_scan.h"
+
+#include <cassert>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Check that every field of the groups is the field of the view
+static bool same_fields(const cppsv::row_groups<char>& groups, const cppsv::runtime_cppsv_view<char>& view) {
+    size_t next_row = 1;
+    for (auto group : groups) {
+        if (group.first_row() != next_row) return false;
+        for (size_t row_index = 0; row_index < group.rows(); ++row_index)
+            for (size_t column_index = 0; column_index < group.columns(); ++column_index)
+                if (group.get_field(row_index, column_index) != view.get_row(next_row + row_index)[column_index])
+                    return false;
+        next_row += group.rows();
+    }
+    return next_row == view.rows();
+}
+
+int main() {
+    // 10 data rows
+    auto text = std::string("id,name\n");
+    for (int row = 1; row <= 10; ++row)
+        text += std::to_string(row) + ",name" + std::to_string(row) + "\n";
+    auto view = cppsv::runtime_cppsv_view<char>(text);
+    assert(view.rows() == 11);
+
+    // The last group is shorter than the others
+    auto groups = cppsv::row_groups<char>(view, 4);
+    assert(groups.size() == 3 && groups[0].rows() == 4 && groups[2].rows() == 2);
+    assert(groups[2].first_row() == 9 && groups[2].get_field(1, 1) == "name10");
+    assert(same_fields(groups, view));
+
+    // One row per group, and a group row count of 0 is taken as 1
+    auto single = cppsv::row_groups<char>(view, 1);
+    assert(single.size() == 10 && single[9].rows() == 1 && single[9].get_field(0, 0) == "10");
+    assert(same_fields(single, view) && cppsv::row_groups<char>(view, 0).size() == 10);
+    // A single group holding every row
+    auto whole = cppsv::row_groups<char>(view, 100);
+    assert(whole.size() == 1 && whole[0].rows() == 10 && same_fields(whole, view));
+
+    // Quoted and trimmed fields are not in buffer order
+    auto options = cppsv::parse_options{ cppsv::trim_policy::spaces };
+    auto quoted = cppsv::runtime_cppsv_view<char>(std::string(
+        "key,value\n"
+        "  a  ,\"x,y\"\n"
+        "\"b\"\"c\",  d\n"
+        "e,\"\"\n"), options);
+    assert(quoted.rows() == 4);
+    auto quoted_groups = cppsv::row_groups<char>(quoted, 2);
+    assert(quoted_groups.size() == 2 && same_fields(quoted_groups, quoted));
+    assert(quoted_groups[0].get_field(0, 0) == "a" && quoted_groups[0].get_field(0, 1) == quoted.get_row(1)[1]);
+
+    // Every row is visited exactly once across threads
+    auto visits = std::vector<std::atomic<int>>(view.rows());
+    single.for_each_group([&](const auto& group) {
+        for (size_t row_index = 0; row_index < group.rows(); ++row_index)
+            ++visits[group.first_row() + row_index];
+    }, 4);
+    assert(!visits[0]);
+    for (size_t row_index = 1; row_index < view.rows(); ++row_index)
+        assert(visits[row_index] == 1);
+    // More threads than groups
+    auto sum = std::atomic<size_t>(0);
+    groups.for_each_group([&](const auto& group) {
+        for (size_t row_index = 0; row_index < group.rows(); ++row_index)
+            sum += std::stoi(std::string(group.get_field(row_index, 0)));
+    }, 16);
+    assert(sum == 55);
+    return 0;
+}
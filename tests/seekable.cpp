@@ -0,0 +1,82 @@
+#include "../include/cppsv_seekable.h"
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+// Frames are stored uncompressed
+struct copy_decompress {
+    bool operator()(void* dst, size_t dst_size, const void* src, size_t src_size) const noexcept {
+        if (dst_size != src_size) return false;
+        std::memcpy(dst, src, src_size);
+        return true;
+    }
+};
+
+struct failing_decompress {
+    bool operator()(void*, size_t, const void*, size_t) const noexcept {
+        return false;
+    }
+};
+
+static void put_u32(std::string& out, uint32_t value) {
+    for (int index = 0; index < 4; ++index)
+        out.push_back(static_cast<char>(value >> (8 * index)));
+}
+
+// Build an archive of frames followed by a seek table
+static std::string make_archive(const std::vector<std::string>& frames) {
+    auto out = std::string();
+    auto table = std::string();
+    for (const auto& frame : frames) {
+        out += frame;
+        put_u32(table, static_cast<uint32_t>(frame.size()));
+        put_u32(table, static_cast<uint32_t>(frame.size()));
+    }
+    put_u32(table, static_cast<uint32_t>(frames.size()));
+    table.push_back(0);
+    put_u32(table, cppsv::seek_table::seekable_magic);
+    put_u32(out, cppsv::seek_table::skippable_magic);
+    put_u32(out, static_cast<uint32_t>(table.size()));
+    return out + table;
+}
+
+template <typename View>
+static bool throws_out_of_range(const View& view, size_t row_index) {
+    try {
+        view.get_field("Age", row_index);
+    }
+    catch (const std::out_of_range&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    auto archive = make_archive({ "Name,Age\nA,1\nB,2\n", "C,3\n", "D,4\nE,5\nF,6\n" });
+    auto view = cppsv::seekable_cppsv_view<char, copy_decompress>(archive);
+    assert(view.valid() && view.frame_count() == 3);
+    assert(view.get_row(0)[0] == "Name" && view.get_row(3)[0] == "C" && view.get_field("Age", 6) == "6");
+    assert(throws_out_of_range(view, 7));
+    assert(!view.get_frame(3));
+    size_t rows = 0;
+    view.for_each_row([&](const auto&) { ++rows; });
+    assert(rows == 7);
+
+    // Fixed row counts, the second frame is shorter than declared
+    auto fixed = cppsv::seekable_cppsv_view<char, copy_decompress>(archive, 2);
+    assert(fixed.get_field("Age", 2) == "2" && fixed.get_field("Age", 3) == "3");
+    assert(throws_out_of_range(fixed, 4) && throws_out_of_range(fixed, 7));
+
+    // No seek table, there are no frames
+    auto invalid = cppsv::seekable_cppsv_view<char, copy_decompress>(std::string("Name,Age\nA,1\n"));
+    assert(!invalid.valid() && !invalid.get_frame(0) && !invalid.find_frame(0));
+    assert(throws_out_of_range(invalid, 0) && throws_out_of_range(invalid, 1));
+    invalid.for_each_row([](const auto&) { assert(false); });
+
+    // Frames that cannot be decompressed
+    auto corrupt = cppsv::seekable_cppsv_view<char, failing_decompress>(archive);
+    assert(corrupt.valid() && !corrupt.get_frame(0) && !corrupt.get_frame(1));
+    assert(throws_out_of_range(corrupt, 0) && throws_out_of_range(corrupt, 4));
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "../include/cppsv_table.h"
+#include "../include/cppsv_rt.h"
+
+#include <cassert>
+#include <string>
+#include <string_view>
+
+CPPSV_VIEW_BEGIN
+"\"" R",,"cppsv-fmt(cppsv"
+name,birth,height
+Ana,1990,1.62
+"Silva, Joao",1985,1.80
+"say ""hi""",2001,1.75
+),,"cppsv-fmt"
+CPPSV_VIEW_NAME(people_csv);
+
+// The same csv, tokenized at runtime
+static const std::string people_text =
+    "name,birth,height\n"
+    "Ana,1990,1.62\n"
+    "\"Silva, Joao\",1985,1.80\n"
+    "\"say \"\"hi\"\"\",2001,1.75\n";
+
+struct person {
+    std::string_view name;
+    int birth;
+    double height;
+};
+
+// Constant initialized, built by a row function
+constinit auto people = cppsv::make_table<person>(people_csv, [](const auto& row) {
+    return person{
+        row[0],
+        cppsv::convert<int>(row[1].begin(), row[1].end()).value(),
+        cppsv::convert<double>(row[2].begin(), row[2].end()).value()
+    };
+});
+static_assert(decltype(people)::size() == 3);
+
+// Tuples of the first columns and a single column
+constinit auto births = cppsv::make_table<std::string_view, int>(people_csv);
+constexpr auto heights = cppsv::make_table<double, 2>(people_csv);
+static_assert(heights[1] == 1.80 && heights.find_index([](double height) { return height > 1.7; }) == 1);
+
+int main() {
+    assert(people[0].name == "Ana" && people[0].birth == 1990 && people[2].height == 1.75);
+    assert(people[1].name == std::get<0>(births[1]) && std::get<1>(births[2]) == 2001);
+    // Constant initialized tables are writable
+    people[0].birth = 1991;
+    assert(people.find_index([](const person& row) { return row.birth == 1991; }) == 0);
+
+    // A view over the embedded table has the rows and fields of the tokenized csv
+    auto embedded = cppsv::runtime_cppsv_view<char>::from_embedded(people_csv);
+    auto tokenized = cppsv::runtime_cppsv_view<char>(people_text);
+    assert(embedded.rows() == 4 && embedded.columns() == 3);
+    assert(embedded.rows() == tokenized.rows() && embedded.columns() == tokenized.columns());
+    for (size_t row_index = 0; row_index < embedded.rows(); ++row_index)
+        for (size_t column_index = 0; column_index < embedded.columns(); ++column_index)
+            assert(embedded.get_row(row_index)[column_index] == tokenized.get_row(row_index)[column_index]);
+    assert(embedded.get_field("name", 2) == tokenized.get_field("name", 2));
+    assert(embedded.get_column<int>(1).value() == tokenized.get_column<int>(1).value());
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "../include/cppsv.h"
+#include "../include/cppsv_rt.h"
+
+#include <cassert>
+#include <string>
+#include <vector>
+#include <string_view>
+
+using rows = std::vector<std::vector<std::string>>;
+
+// Fields of a csv tokenized at runtime with the options, row by row
+static rows tokenized(const char* text, cppsv::parse_options options) {
+    auto view = cppsv::runtime_cppsv_view<char>(std::string(text), options);
+    auto out = rows();
+    for (size_t row_index = 0; row_index < view.rows(); ++row_index)
+        out.emplace_back(view.get_row(row_index).begin(), view.get_row(row_index).end());
+    return out;
+}
+
+// Compile time options, blank lines, comment lines and a quoted field spanning lines
+CPPSV_VIEW_BEGIN
+"\"" R",,"cppsv-fmt(cppsv"
+# a comment before the header row
+
+name, note ,count
+   
+Ana , "two
+# not a comment
+
+lines" ,1
+; another comment
+ Bo,	tab	,2
+),,"cppsv-fmt"
+CPPSV_VIEW_NAME_WITH_OPTIONS(notes_csv, .trim = cppsv::trim_policy::spaces, .comment = "#;", .skip_blank_lines = true);
+
+static_assert(notes_csv.options().trim == cppsv::trim_policy::spaces && notes_csv.options().skip_blank_lines);
+static_assert(notes_csv.rows() == 3 && notes_csv.columns() == 3);
+static_assert(notes_csv.embedded_fields()[0][1] == "note" && notes_csv.embedded_fields()[0][2] == "count");
+static_assert(notes_csv.embedded_fields()[1][0] == "Ana" && notes_csv.embedded_fields()[1][1] == "two\n# not a comment\n\nlines");
+// Tabs are not trimmed by trim_policy::spaces
+static_assert(notes_csv.embedded_fields()[2][0] == "Bo" && notes_csv.embedded_fields()[2][1] == "\ttab\t");
+
+// Chunks with their own header rows, the columns of the second one are reordered
+CPPSV_VIEW_BEGIN
+"\"" R",,"cppsv-fmt(cppsv"
+id,name,city
+1,Ana,Lima
+),,"cppsv-fmt"
+CPPSV_VIEW_NEXT
+"\"" R",,"cppsv-fmt(cppsv"
+city,id,name
+Rome,2,Bo
+Oslo,3,Cy
+),,"cppsv-fmt"
+CPPSV_VIEW_NAME_WITH_OPTIONS(chunks_csv, .chunk_headers = true);
+
+static_assert(chunks_csv.rows() == 4 && chunks_csv.columns() == 3);
+static_assert(chunks_csv.embedded_fields()[0][2] == "city" && chunks_csv.embedded_fields()[1][2] == "Lima");
+static_assert(chunks_csv.embedded_fields()[2][0] == "2" && chunks_csv.embedded_fields()[2][1] == "Bo"
+    && chunks_csv.embedded_fields()[2][2] == "Rome");
+static_assert(chunks_csv.embedded_fields()[3][0] == "3" && chunks_csv.embedded_fields()[3][2] == "Oslo");
+
+#ifdef CPPSV_ERROR_schema_column_not_found
+// The second chunk has a column missing from the first one
+CPPSV_VIEW_BEGIN
+"\"" R",,"cppsv-fmt(cppsv"
+id,name,city
+1,Ana,Lima
+),,"cppsv-fmt"
+CPPSV_VIEW_NEXT
+"\"" R",,"cppsv-fmt(cppsv"
+id,name,country
+2,Bo,Italy
+),,"cppsv-fmt"
+CPPSV_VIEW_NAME_WITH_OPTIONS(unmatched_csv, .chunk_headers = true);
+
+static_assert(unmatched_csv.rows() == 3);
+#endif
+
+// skip_lines stops at the first line that is not skipped
+static_assert([] {
+    constexpr std::string_view text = "#a\n\t \r\n#b\nx,y\n#c\n";
+    auto options = cppsv::parse_options{ .comment = "#", .skip_blank_lines = true };
+    return cppsv::skip_lines(text.begin(), text.end(), options) == text.begin() + 10
+        && cppsv::skip_lines(text.begin() + 14, text.end(), options) == text.end()
+        && cppsv::skip_lines(text.begin(), text.end(), cppsv::parse_options{}) == text.begin();
+}());
+
+// tokenize calls the function with each field and its column and row indices
+static_assert([] {
+    constexpr std::string_view text = "a, b\n\"c,d\" ,e\n";
+    size_t fields = 0;
+    bool same = true;
+    constexpr std::string_view expected[2][2]{ { "a", "b" }, { "c,d", "e" } };
+    cppsv::tokenize(text, 2, cppsv::parse_options{ cppsv::trim_policy::spaces },
+        [&](size_t index_x, size_t index_y, std::string_view field) {
+            if (index_y < 2) same &= field == expected[index_y][index_x], ++fields;
+        });
+    return same && fields == 4;
+}());
+
+int main() {
+    // Every trim policy, with CRLF line endings
+    const char* padded = "a , b\r\n \t1\t , \"x\" \r\n";
+    assert((tokenized(padded, { cppsv::trim_policy::none }) == rows{ { "a ", " b\r" }, { " \t1\t ", " \"x\" \r" } }));
+    assert((tokenized(padded, { cppsv::trim_policy::spaces }) == rows{ { "a", "b\r" }, { "\t1\t", "\"x\" \r" } }));
+    assert((tokenized(padded, { cppsv::trim_policy::tabs }) == rows{ { "a", "b\r" }, { "1", "\"x\" \r" } }));
+    // Carriage returns are whitespace, so CRLF line endings are removed and quotes stripped
+    assert((tokenized(padded, { cppsv::trim_policy::whitespace }) == rows{ { "a", "b" }, { "1", "x" } }));
+    // Quoted fields keep their whitespace inside the quotes
+    assert((tokenized("a,b\n\" x \",y\n", { cppsv::trim_policy::whitespace }) == rows{ { "a", "b" }, { " x ", "y" } }));
+
+    // Comment and blank lines, also before the header row, but not inside quoted fields
+    const char* commented = "#first\n\na,b\r\n \t\r\n#c,d\n1,\"2\n#3\n\n4\"\r\n;x\n5,6\r\n\n";
+    auto options = cppsv::parse_options{ cppsv::trim_policy::whitespace, "#;", true };
+    assert((tokenized(commented, options) == rows{ { "a", "b" }, { "1", "2\n#3\n\n4" }, { "5", "6" } }));
+    // Without skip_blank_lines a blank line is a row
+    options.skip_blank_lines = false;
+    assert((tokenized("#c\na,b\n\n1,2\n", options) == rows{ { "a", "b" }, { "", "" }, { "1", "2" } }));
+    // Comment characters only count at the start of a line
+    assert((tokenized("a,b\n1,#2\n", options) == rows{ { "a", "b" }, { "1", "#2" } }));
+    return 0;
+}